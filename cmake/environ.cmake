@@ -3,6 +3,10 @@ find_program(CXX clang++)
 set(CMAKE_CXX_COMPILER ${CXX})
 set(CMAKE_CXX_STANDARD 20)
 
+# Kernels of the statevector engines use OpenMP SIMD directives (no OpenMP runtime is linked),
+# they are vectorized by optimized builds (see CMAKE_BUILD_TYPE)
+add_compile_options(-fopenmp-simd)
+
 # Set environment variables
 set(PROJECT_DIR ${CMAKE_SOURCE_DIR})
 set(SRC_DIR ${PROJECT_DIR}/src)
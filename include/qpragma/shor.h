@@ -27,6 +27,21 @@
 
 #include "qpragma/shor/fraction.h"
 #include "qpragma/shor/continued_fraction.h"
+#include "qpragma/shor/post_processing.h"
+#include "qpragma/shor/lattice.h"
+#include "qpragma/shor/cache.h"
+#include "qpragma/shor/trace.h"
+#include "qpragma/shor/resources.h"
+#include "qpragma/shor/deadline.h"
+#include "qpragma/shor/classical.h"
+#include "qpragma/shor/squaring_chain.h"
+#include "qpragma/shor/compiled_modulus.h"
+#include "qpragma/shor/storage.h"
+#include "qpragma/shor/engine.h"
+#include "qpragma/shor/emulator.h"
+#include "qpragma/shor/autotuner.h"
+#include "qpragma/shor/base_scheduler.h"
+#include "qpragma/shor/multiplier.h"
 #include "qpragma/shor/core.h"
 #include "qpragma/shor/display.h"
 
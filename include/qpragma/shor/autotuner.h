@@ -0,0 +1,124 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/autotuner.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Cost model of the strategies of "find_factors", calibrated once per machine
+ */
+
+#ifndef QPRAGMA_SHOR_AUTOTUNER_H
+#define QPRAGMA_SHOR_AUTOTUNER_H
+
+#include <map>
+#include <string>
+#include <cstdint>
+
+#include "qpragma/shor/storage.h"
+#include "qpragma/shor/engine.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Cost model of a machine
+     * Durations are fitted on a calibration benchmark (see "calibrate"):
+     *  - classical_ns: duration of the classical order finder per sqrt(N) (baby-step giant-step)
+     *  - engine_ns: duration of a step of the statevector emulator per amplitude, for each number
+     *    of threads (1 thread is the reference engine, more threads use the parallel engine)
+     *  - shot_factor: duration of an additional shot of the shot tree, relative to the first one
+     *  - mapped_factor: slowdown of amplitudes stored in memory-mapped files
+     *  - memory_bytes: memory available for the amplitudes, larger registers are stored out-of-core
+     */
+    struct cost_model {
+        double classical_ns = 0.;
+        std::map<uint64_t, double> engine_ns;
+        double shot_factor = 1.;
+        double mapped_factor = 1.;
+        uint64_t memory_bytes = 0UL;
+
+        // Load or save a model (the file is a list of "key value" lines, replaced atomically by "save")
+        static cost_model load(const std::string & /* path */);
+        void save(const std::string & /* path */) const;
+    };
+
+
+    /**
+     * Options of the calibration
+     *  - size: size of the register emulated by the calibration
+     *  - repetitions: each duration is the fastest of these repetitions
+     *  - max_threads: largest number of threads calibrated (0 means one per hardware thread), the
+     *    numbers of threads calibrated are powers of two
+     *  - directory: directory of the memory-mapped files (empty means the temporary directory)
+     */
+    struct calibration_options {
+        uint64_t size = 16UL;
+        uint64_t repetitions = 3UL;
+        uint64_t max_threads = 0UL;
+        std::string directory = "";
+    };
+
+
+    /**
+     * Calibrate the cost model of this machine
+     */
+    cost_model calibrate(const calibration_options & /* options */ = calibration_options());
+
+    // Load the model stored at "path", or calibrate this machine and store its model at "path"
+    cost_model load_or_calibrate(const std::string & /* path */, const calibration_options & /* options */ = calibration_options());
+
+
+    /**
+     * Strategy of a factorization, minimizing its expected duration
+     *  - classical: orders are computed by the classical order finder, instead of the emulator
+     *  - shots: number of measurements sampled per base by the emulator
+     *  - storage, engine: storage of the amplitudes and engine of the emulator
+     *  - expected_ms: expected duration of the factorization
+     */
+    struct tuning {
+        bool classical = false;
+        uint64_t shots = 1UL;
+        storage_options storage = storage_options();
+        engine_options engine = engine_options();
+        double expected_ms = 0.;
+    };
+
+
+    /**
+     * Choose the strategy dividing "N_value" (stored in a register of "size" qubits)
+     * The expected duration of a strategy is the duration of a base divided by the probability
+     * that this base splits N, using the prior probabilities of "attempt_budget" (see
+     * "qpragma/shor/post_processing.h"). The shots of a base find its order independently, but
+     * they split N only if this order does: extra shots do not improve the split probability.
+     * Attempts measure 2 * size bits: registers above 31 qubits are not emulated
+     *
+     * Attempts of a factorization are executed one after the other: the number of concurrent
+     * attempts is not tuned, the threads of the machine are only used by the parallel engine
+     *
+     * The classical order finder is not used if "quantum_only" is true. Out-of-core amplitudes
+     * are stored in "directory" (empty means the temporary directory)
+     */
+    tuning tune(
+        const cost_model & /* model */, uint64_t /* size */, uint64_t /* N_value */, bool /* quantum_only */ = false,
+        const std::string & /* directory */ = ""
+    );
+}
+
+#endif  /* QPRAGMA_SHOR_AUTOTUNER_H */
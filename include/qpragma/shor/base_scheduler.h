@@ -0,0 +1,102 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/base_scheduler.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Selection of the bases used by the attempts of Shor algorithm
+ */
+
+#ifndef QPRAGMA_SHOR_BASE_SCHEDULER_H
+#define QPRAGMA_SHOR_BASE_SCHEDULER_H
+
+#include <cstdint>
+#include <optional>
+#include <unordered_set>
+
+
+namespace qpragma::shor {
+    /**
+     * Counter-based random stream
+     * The stream is identified by (seed, N, attempt_idx) and the k-th value of the stream is a
+     * function of this key and k only: streams of different attempts are independent and can
+     * be generated in any order (parallel or resumed runs draw the same values)
+     */
+    class random_stream {
+    public:
+        random_stream(uint64_t /* seed */, uint64_t /* N_value */, uint64_t /* attempt_idx */);
+
+        // Next 64 bits value of the stream
+        uint64_t operator()();
+
+        // Next value of the stream, uniformly distributed in [min_value, max_value]
+        uint64_t uniform(uint64_t /* min_value */, uint64_t /* max_value */);
+
+        // Next value of the stream, uniformly distributed in [0, 1)
+        double canonical();
+
+    private:
+        uint64_t _key;
+        uint64_t _counter = 0UL;
+    };
+
+
+    /**
+     * Jacobi symbol (value / N_value), N_value being odd
+     * Returns 0 if value and N are not coprime, -1 if value is a quadratic non-residue
+     * modulo at least one prime factor of N
+     */
+    int jacobi_symbol(uint64_t /* value */, uint64_t /* N_value */);
+
+
+    /**
+     * Base scheduler
+     * Bases used by the attempts of "find_divisor" on a given N are drawn from the random
+     * stream of their attempt, such as:
+     *  - a base is never scheduled twice
+     *  - 1 and N - 1 are never scheduled (their order is respectively 1 and 2, and only give
+     *    trivial divisors)
+     *  - quadratic non-residues (Jacobi symbol equal to -1) are preferred: their order is even
+     */
+    class base_scheduler {
+    public:
+        // Number of values drawn from a stream to find a quadratic non-residue
+        static constexpr uint64_t nb_candidates = 8UL;
+
+        explicit base_scheduler(uint64_t /* N_value */, uint64_t /* seed */ = 1234UL);
+
+        // Base of the next attempt (no value if all the bases were scheduled)
+        std::optional<uint64_t> next();
+
+        // Checks if a base can be scheduled
+        bool is_eligible(uint64_t /* base */) const;
+
+        // Number of scheduled bases
+        uint64_t scheduled() const;
+
+    private:
+        uint64_t _N_value;
+        uint64_t _seed;
+        std::unordered_set<uint64_t> _scheduled;
+    };
+}
+
+#endif  /* QPRAGMA_SHOR_BASE_SCHEDULER_H */
@@ -0,0 +1,106 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/cache.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Persistent cache of orders and factorizations
+ */
+
+#ifndef QPRAGMA_SHOR_CACHE_H
+#define QPRAGMA_SHOR_CACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <optional>
+
+
+namespace qpragma::shor {
+    /**
+     * Persistent cache of orders and factorizations
+     * The cache is an append-only file, made of a header followed by fixed size records. Two
+     * kinds of records are stored:
+     *  - factor records: "factor" is a known factor of N
+     *  - order records: "order" is the order of "base" modulo N
+     *
+     * The file is memory-mapped (read-only) and indexed in memory. Writers append records at the
+     * end of the file under an exclusive lock, readers scan new records under a shared lock. The
+     * file never shrinks: each record is protected by a checksum, a record partially written
+     * (i.e. after a crash) is skipped and the next record is written at the following record
+     * boundary. Any number of processes can share the same cache
+     */
+    class order_cache {
+    private:
+        struct record {
+            uint64_t kind;
+            uint64_t N_value;
+            uint64_t key;
+            uint64_t value;
+            uint64_t checksum;
+        };
+
+        std::string _path;
+        bool _read_only;
+        int _file_descriptor = -1;
+
+        // Mapped file
+        const std::byte * _mapping = nullptr;
+        std::size_t _mapped_size = 0UL;
+        std::size_t _nb_scanned = 0UL;  // Records read (invalid records included)
+        std::size_t _nb_indexed = 0UL;  // Valid records
+
+        // Index
+        std::map<uint64_t, std::vector<uint64_t>> _factors;
+        std::map<std::pair<uint64_t, uint64_t>, uint64_t> _orders;
+
+        void _unmap();
+        void _scan();
+        void _index(const record &);
+        void _append(record);
+
+    public:
+        // Constructor (non-copyable)
+        explicit order_cache(const std::string & /* path */, bool /* read_only */ = false);
+        order_cache(const order_cache &) = delete;
+        order_cache & operator=(const order_cache &) = delete;
+
+        // Destructor
+        ~order_cache();
+
+        // Lookup (records appended by other processes are loaded if the key is unknown)
+        std::vector<uint64_t> find_factors(uint64_t /* N_value */);
+        std::optional<uint64_t> find_order(uint64_t /* base */, uint64_t /* N_value */);
+
+        // Store new entries
+        void store_factors(uint64_t /* N_value */, const std::vector<uint64_t> & /* factors */);
+        void store_order(uint64_t /* base */, uint64_t /* N_value */, uint64_t /* order */);
+
+        // Load records appended since the last refresh
+        void refresh();
+        std::size_t size() const;
+    };
+}
+
+#endif  /* QPRAGMA_SHOR_CACHE_H */
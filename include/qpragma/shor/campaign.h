@@ -0,0 +1,85 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/campaign.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Monte-Carlo campaigns measuring the success rate of Shor algorithm
+ */
+
+#ifndef QPRAGMA_SHOR_CAMPAIGN_H
+#define QPRAGMA_SHOR_CAMPAIGN_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+#include "qpragma/shor/post_processing.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Generate a corpus of semiprimes
+     * Returns all the numbers N = p * q (p and q are distinct odd primes) such as N
+     * can be stored in a register of "size" qubits
+     */
+    std::vector<uint64_t> semiprimes(uint64_t /* size */);
+
+
+    /**
+     * Seeded base of an attempt
+     * The base used by the attempt "attempt_idx" only depends on the seed, N and the index of
+     * the attempt: attempts can be executed in any order. Unlike "find_divisor", bases are
+     * drawn uniformly (with repetitions) to measure the success probability of a random base
+     */
+    uint64_t campaign_base(uint64_t /* seed */, uint64_t /* N_value */, uint64_t /* attempt_idx */);
+
+
+    /**
+     * Statistics of a campaign for a given (N, SIZE)
+     */
+    struct campaign_statistics {
+        uint64_t N_value = 0UL;
+        uint64_t size = 0UL;
+        uint64_t attempts = 0UL;
+        std::array<uint64_t, 5UL> outcomes {};
+        double total_time_ms = 0.;
+
+        // Add an attempt, or merge statistics
+        void record(attempt_outcome /* outcome */, double /* time_ms */);
+        campaign_statistics & operator+=(const campaign_statistics &);
+
+        // Results
+        uint64_t count(attempt_outcome) const;
+        double success_probability() const;  // Among attempts using the quantum part
+        double time_per_attempt_ms() const;
+    };
+
+
+    /**
+     * Write statistics using the CSV format
+     */
+    void write_csv_header(std::ostream &);
+    void write_csv(std::ostream &, const campaign_statistics &);
+}
+
+#endif  /* QPRAGMA_SHOR_CAMPAIGN_H */
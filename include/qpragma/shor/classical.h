@@ -0,0 +1,67 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/classical.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Classical engines, used when a quantum attempt is too expensive
+ */
+
+#ifndef QPRAGMA_SHOR_CLASSICAL_H
+#define QPRAGMA_SHOR_CLASSICAL_H
+
+#include <cstdint>
+
+#include "qpragma/shor/deadline.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Trial division
+     * Find the smallest divisor of N by trial division. The deadline is checked regularly:
+     * 0 is returned if the deadline expires (or if N is prime)
+     */
+    uint64_t trial_division(uint64_t /* N_value */, const deadline & /* limit */ = deadline());
+
+
+    /**
+     * Classical order finding
+     * Computes the order of x modulo N (the smallest r > 0 such as x^r = 1 mod N) using
+     * baby-step giant-step. Orders too large for the table of baby steps are found using
+     * Pollard's kangaroo, which finds a multiple of the order, reduced to the order using
+     * the prime factors of this multiple
+     *
+     * 0 is returned if x is not coprime with N, or if the deadline expires
+     */
+    uint64_t classical_order(uint64_t /* x_value */, uint64_t /* N_value */, const deadline & /* limit */ = deadline());
+
+
+    /**
+     * Validate an order found by the post-processing
+     * Checks that "order" is the order of x modulo N: x^order = 1, and x^(order / q) is not 1
+     * for each prime factor q of the order (powers are computed independently of "pow_mod",
+     * used by the post-processing). std::logic_error is thrown otherwise. The minimality is
+     * not checked if the deadline expires
+     */
+    void validate_order(uint64_t /* x_value */, uint64_t /* order */, uint64_t /* N_value */, const deadline & /* limit */ = deadline());
+}
+
+#endif  /* QPRAGMA_SHOR_CLASSICAL_H */
@@ -0,0 +1,253 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/compiled_modulus.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Classical part of Shor algorithm computed at compile time, for a modulus known at build time
+ */
+
+#ifndef QPRAGMA_SHOR_COMPILED_MODULUS_H
+#define QPRAGMA_SHOR_COMPILED_MODULUS_H
+
+#include <bit>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+
+#include "qpragma/shor/fraction.h"
+#include "qpragma/shor/continued_fraction.h"
+#include "qpragma/shor/post_processing.h"
+#include "qpragma/shor/squaring_chain.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Tables of a modulus known at compile time
+     * Every table is indexed by the base and computed at compile time:
+     *  - gcds: gcd of the base and N
+     *  - chains: squaring chain of the base (constants of the controlled multiplications)
+     *  - orders: order of the base modulo N (0 if the base is not coprime with N)
+     *  - divisors: divisor given by gcd(x^(r/2) - 1, N) (0 if the order is odd or if only
+     *    trivial divisors are found)
+     *
+     * Tables have N entries: only small moduli are supported
+     */
+    template <uint64_t SIZE, uint64_t N_VALUE>
+    class compiled_modulus {
+    public:
+        static constexpr uint64_t max_modulus = 1UL << 10UL;
+        static constexpr uint64_t nb_bits = 2UL * SIZE;
+
+        static_assert(N_VALUE < (1UL << SIZE), "N does not fit in the quantum register");
+        static_assert(N_VALUE < max_modulus, "N is too large to compute tables at compile time");
+        static_assert(N_VALUE > 3UL and N_VALUE % 2UL == 1UL, "N is expected to be odd");
+
+        using chain_type = std::array<chain_step, nb_bits>;
+
+    private:
+        static constexpr std::array<uint64_t, N_VALUE> _gcds() {
+            std::array<uint64_t, N_VALUE> result {};
+
+            for (uint64_t base = 0UL; base < N_VALUE; ++base) {
+                result[base] = std::gcd(base, N_VALUE);
+            }
+
+            return result;
+        }
+
+        // Squaring chains: the constant of the step "t" (starting from the last step) is x^(2^t),
+        // with r = 2^e o (o odd), 2^t modulo r is periodic once t >= e, and its period is the
+        // order of 2 modulo o. Repeated constants are found without comparing the steps
+        static constexpr std::array<chain_type, N_VALUE> _chains() {
+            std::array<chain_type, N_VALUE> result {};
+            auto orders = _orders();
+
+            for (uint64_t base = 1UL; base < N_VALUE; ++base) {
+                if (orders[base] == 0UL) {
+                    continue;
+                }
+
+                const uint64_t nb_twos = std::countr_zero(orders[base]);
+                const uint64_t odd_part = orders[base] >> nb_twos;
+                uint64_t period = 0UL;
+
+                for (uint64_t length = 1UL, value = 2UL % odd_part; length < nb_bits; ++length, value = (2UL * value) % odd_part) {
+                    if (value == 1UL % odd_part) {
+                        period = length;
+                        break;
+                    }
+                }
+
+                uint64_t constant = base;
+
+                for (uint64_t step = 0UL; step < nb_bits; ++step) {
+                    uint64_t last_step = step;
+
+                    if (step >= nb_twos and period != 0UL) {
+                        last_step += period * ((nb_bits - 1UL - step) / period);
+                    }
+
+                    result[base][nb_bits - 1UL - step] = chain_step {
+                        .constant = constant,
+                        .identity = constant == 1UL,
+                        .first_occurrence = nb_bits - 1UL - last_step
+                    };
+
+                    constant = (constant * constant) % N_VALUE;
+                }
+            }
+
+            return result;
+        }
+
+        // Carmichael function of N: the order of every base divides it
+        static constexpr uint64_t _carmichael() {
+            uint64_t result = 1UL;
+            uint64_t remaining = N_VALUE;
+
+            for (uint64_t prime = 3UL; prime * prime <= remaining; prime += 2UL) {
+                if (remaining % prime != 0UL) {
+                    continue;
+                }
+
+                // lambda(p^k) = p^(k - 1) (p - 1) for odd primes
+                uint64_t value = prime - 1UL;
+                remaining /= prime;
+
+                for (; remaining % prime == 0UL; remaining /= prime) {
+                    value *= prime;
+                }
+
+                result = std::lcm(result, value);
+            }
+
+            return remaining > 1UL ? std::lcm(result, remaining - 1UL) : result;
+        }
+
+        static constexpr std::array<uint64_t, N_VALUE> _orders() {
+            std::array<uint64_t, N_VALUE> result {};
+            const uint64_t lambda = _carmichael();
+
+            // Prime factors of lambda (with multiplicity)
+            std::array<uint64_t, 64UL> primes {};
+            uint64_t nb_primes = 0UL;
+
+            for (uint64_t prime = 2UL, remaining = lambda; remaining > 1UL; ++prime) {
+                for (; remaining % prime == 0UL; remaining /= prime) {
+                    primes[nb_primes++] = prime;
+                }
+            }
+
+            for (uint64_t base = 1UL; base < N_VALUE; ++base) {
+                if (std::gcd(base, N_VALUE) != 1UL) {
+                    continue;
+                }
+
+                // Remove the prime factors of lambda as long as x^r is still equal to 1
+                uint64_t order = lambda;
+
+                for (uint64_t idx = 0UL; idx < nb_primes; ++idx) {
+                    if (pow_mod(base, order / primes[idx], N_VALUE) == 1UL) {
+                        order /= primes[idx];
+                    }
+                }
+
+                result[base] = order;
+            }
+
+            return result;
+        }
+
+        static constexpr std::array<uint64_t, N_VALUE> _divisors() {
+            std::array<uint64_t, N_VALUE> result {};
+            auto orders = _orders();
+
+            for (uint64_t base = 1UL; base < N_VALUE; ++base) {
+                if (orders[base] == 0UL or orders[base] % 2UL == 1UL) {
+                    continue;
+                }
+
+                // x^(r/2) is a square root of 1 different from 1, it gives a divisor unless it is -1
+                if (uint64_t root = pow_mod(base, orders[base] / 2UL, N_VALUE); root != N_VALUE - 1UL) {
+                    result[base] = std::gcd(root - 1UL, N_VALUE);
+                }
+            }
+
+            return result;
+        }
+
+    public:
+        static constexpr std::array<uint64_t, N_VALUE> gcds = _gcds();
+        static constexpr std::array<chain_type, N_VALUE> chains = _chains();
+        static constexpr std::array<uint64_t, N_VALUE> orders = _orders();
+        static constexpr std::array<uint64_t, N_VALUE> divisors = _divisors();
+
+        /**
+         * Post-process a measurement
+         * The order found by the continued fraction algorithm is checked using the table of
+         * orders, and the divisor is read from the table of divisors
+         */
+        static constexpr attempt_result post_process(uint64_t measurement, uint64_t base) {
+            attempt_result result;
+
+            // Base not coprime with N: a divisor is found classically
+            if (gcds[base] != 1UL) {
+                result.outcome = attempt_outcome::classical_gcd;
+                result.factors = { gcds[base], N_VALUE / gcds[base] };
+                std::ranges::sort(result.factors);
+                return result;
+            }
+
+            // A candidate is a multiple of the order
+            uint64_t candidate = find_candidate_if(
+                fraction(measurement, 1UL << nb_bits), N_VALUE,
+                [base](uint64_t value) { return value % orders[base] == 0UL; }
+            );
+
+            if (candidate == 0UL) {
+                result.outcome = attempt_outcome::no_candidate;
+                return result;
+            }
+
+            result.order = orders[base];
+
+            if (orders[base] % 2UL == 1UL) {
+                result.outcome = attempt_outcome::odd_order;
+            }
+
+            else if (divisors[base] == 0UL) {
+                result.outcome = attempt_outcome::trivial_split;
+            }
+
+            else {
+                result.outcome = attempt_outcome::success;
+                result.factors = { divisors[base], N_VALUE / divisors[base] };
+                std::ranges::sort(result.factors);
+            }
+
+            return result;
+        }
+    };
+}
+
+#endif  /* QPRAGMA_SHOR_COMPILED_MODULUS_H */
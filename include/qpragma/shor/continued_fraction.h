@@ -25,8 +25,11 @@
 #ifndef QPRAGMA_SHOR_CONTINUED_FRACTION_H
 #define QPRAGMA_SHOR_CONTINUED_FRACTION_H
 
-#include <list>
+#include <vector>
+#include <cstdint>
+
 #include "qpragma/shor/fraction.h"
+#include "qpragma/shor/deadline.h"
 
 namespace qpragma::shor {
     /**
@@ -34,21 +37,41 @@ namespace qpragma::shor {
      * This function returns the complete decomposition, as any rational number has a finite
      * decomposition
      */
-    std::list<int64_t> continued_fraction(fraction);
+    constexpr std::vector<int64_t> continued_fraction(fraction);
 
 
     /**
      * Find candidate
      * Given a fraction p/q, find a candidate
      * r such as the following requirements are satisfied:
-     *  - c/r is a convergent of p/q (c and r are coprime)
-     *  - abs(p/q - c/r) <= 1/2q
-     *  - r is even
+     *  - c/d is a convergent of p/q (c and d are coprime)
+     *  - abs(p/q - c/d) <= 1/2q
+     *  - r = k * d where k is a small integer (r/d = gcd(c, r) when c/r has been simplified)
      *  - x^r % N == 1
      *
-     * If no such r is find, 0 is returned
+     * The candidate may be odd. If no such r is find (or if the deadline expires), 0 is returned
+     */
+    constexpr uint64_t find_candidate(
+        const fraction & /* fraction */, uint64_t /* x_value */, uint64_t /* N_value */, const deadline & /* limit */ = deadline()
+    );
+
+
+    /**
+     * Find candidate using a custom check
+     * Same as above, but "x^r % N == 1" is replaced by "is_candidate(r)" (used when the
+     * order of x is already known, e.g. tables computed at compile time)
+     */
+    template <typename PREDICATE>
+    constexpr uint64_t find_candidate_if(
+        const fraction & /* fraction */, uint64_t /* N_value */, PREDICATE && /* is_candidate */, const deadline & /* limit */ = deadline()
+    );
+
+
+    /**
+     * Computes (x * y) % z
+     * The product is computed on 128 bits: it does not overflow for any modulus
      */
-    uint64_t find_candidate(const fraction & /* fraction */, uint64_t /* x_value */, uint64_t /* N_value */);
+    constexpr uint64_t mul_mod(uint64_t /* lhs */, uint64_t /* rhs */, uint64_t /* modulus */);
 
 
     /**
@@ -56,7 +79,24 @@ namespace qpragma::shor {
      * The C++ implementation manages double, which may return inacurrate results.
      * Moreover, the modulus avoid overflow
      */
-    uint64_t pow_mod(uint64_t /* base */, uint64_t /* exponent */, uint64_t /* modulus */);
+    constexpr uint64_t pow_mod(uint64_t /* base */, uint64_t /* exponent */, uint64_t /* modulus */);
+
+
+    /**
+     * Computes pow(x, 2^y) % z
+     * This function uses exponentiation by squaring, and gives the constants of the
+     * controlled multiplications of the phase estimation
+     */
+    constexpr uint64_t mod_exp(uint64_t /* base */, uint64_t /* exponent */, uint64_t /* modulus */);
+
+
+    /**
+     * Computes the inverse of x modulo z
+     * x and z are expected to be coprime (extended Euclidean algorithm)
+     */
+    constexpr uint64_t mod_inverse(uint64_t /* value */, uint64_t /* modulus */);
 }
 
+#include "qpragma/shor/continued_fraction.ipp"
+
 #endif  /* QPRAGMA_SHOR_CONTINUED_FRACTION_H */
@@ -0,0 +1,168 @@
+/**
+ * Q-Pragma Shor's algorithm implementation
+ *
+ * This file provide the implementation of the continued fraction algorithm and of the
+ * modular arithmetic. These functions are constexpr and can be used to compute tables
+ * at compile time
+ */
+
+#include <bit>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+
+// Continued fraction implementation
+constexpr std::vector<int64_t> qpragma::shor::continued_fraction(qpragma::shor::fraction to_decompose) {
+    // Init result
+    std::vector<int64_t> result;
+
+    // Decompose item
+    while (true) {
+        fraction item = std::floor(to_decompose);
+        result.push_back(item);
+        to_decompose -= item;
+
+        if (to_decompose == 0UL) {
+            break;
+        }
+
+        to_decompose = 1UL / to_decompose;
+    }
+
+    return result;
+}
+
+
+// Find a candidate
+//
+// Given a fraction [a0, a1, ...], its convergents [a0, a1, ..., aN] are equals
+// to h[N]/k[N]
+//
+// where:
+// h[N] = aN * h[N - 1] + h[N - 2]  (and h[-1] = 1 and h[-2] = 0)
+// k[n] = aN * k[N - 1] + k[N - 2]  (and k[-1] = 0 and k[-2] = 1)
+template <typename PREDICATE>
+constexpr uint64_t qpragma::shor::find_candidate_if(
+    const qpragma::shor::fraction & frac, uint64_t N_value, PREDICATE && is_candidate, const qpragma::shor::deadline & limit
+) {
+    // Computes threshold and the number of multiples checked for each convergent
+    const fraction threshold(1UL, 2UL * frac.denominator());
+    const uint64_t max_multiple = std::bit_width(N_value);
+
+    // Define fraction
+    int64_t h_n = 1;
+    int64_t h_n_prev = 0;
+
+    int64_t k_n = 0;
+    int64_t k_n_prev = 1;
+
+    // Computes all the convergents and checks if these convergents are candidates
+    for (int64_t item: continued_fraction(frac)) {
+        if (not std::is_constant_evaluated() and limit.expired()) {
+            break;
+        }
+
+        // Copy h[N] and k[N]
+        auto h_n_copy = h_n;
+        auto k_n_copy = k_n;
+
+        // Computes h[N + 1] and k[N + 1]
+        h_n = item * h_n + h_n_prev;
+        k_n = item * k_n + k_n_prev;
+
+        h_n_prev = h_n_copy;
+        k_n_prev = k_n_copy;
+
+        // Checks if the convergent is a candidate
+        fraction convergent(h_n, k_n);
+
+        if (std::abs(frac - convergent) >= threshold) {
+            continue;
+        }
+
+        // If c and r are not coprime, the denominator of the convergent is only a divisor
+        // of r: small multiples of this denominator are also checked
+        for (uint64_t multiple = 1UL; multiple <= max_multiple; ++multiple) {
+            uint64_t candidate = multiple * convergent.denominator();
+
+            if (candidate >= N_value) {
+                break;
+            }
+
+            if (is_candidate(candidate)) {
+                return candidate;
+            }
+        }
+    }
+
+    // No value found
+    return 0UL;
+}
+
+
+// Find a candidate (checks x^r % N == 1)
+constexpr uint64_t qpragma::shor::find_candidate(
+    const qpragma::shor::fraction & frac, uint64_t x_value, uint64_t N_value, const qpragma::shor::deadline & limit
+) {
+    return find_candidate_if(frac, N_value, [x_value, N_value](uint64_t candidate) {
+        return pow_mod(x_value, candidate, N_value) == 1UL;
+    }, limit);
+}
+
+
+// Modular multiplication: computes (x * y) % m
+constexpr uint64_t qpragma::shor::mul_mod(uint64_t lhs, uint64_t rhs, uint64_t modulus) {
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(lhs) * rhs) % modulus);
+}
+
+
+// Modular exponentiation: computes b^e % m
+constexpr uint64_t qpragma::shor::pow_mod(uint64_t base, uint64_t exponent, uint64_t modulus) {
+    uint64_t result = 1;
+    uint64_t power = base % modulus;
+
+    while (exponent > 0) {
+        if (exponent % 2 == 1) {
+            result = mul_mod(result, power, modulus);
+        }
+        power = mul_mod(power, power, modulus);
+        exponent /= 2;
+    }
+
+    return result;
+}
+
+
+// Modular exponentiation by squaring: computes b^(2^e) % m
+constexpr uint64_t qpragma::shor::mod_exp(uint64_t base, uint64_t exponent, uint64_t modulus) {
+    uint64_t result = base % modulus;
+
+    for (uint64_t i = 0; i < exponent; ++i) {
+        result = mul_mod(result, result, modulus);
+    }
+
+    return result;
+}
+
+
+// Modular inverse: computes x^(-1) % m
+constexpr uint64_t qpragma::shor::mod_inverse(uint64_t value, uint64_t modulus) {
+    int64_t old_remainder = static_cast<int64_t>(value % modulus);
+    int64_t remainder = static_cast<int64_t>(modulus);
+    int64_t old_coefficient = 1;
+    int64_t coefficient = 0;
+
+    while (remainder != 0) {
+        int64_t quotient = old_remainder / remainder;
+
+        old_remainder = std::exchange(remainder, old_remainder - quotient * remainder);
+        old_coefficient = std::exchange(coefficient, old_coefficient - quotient * coefficient);
+    }
+
+    if (old_remainder != 1) {
+        throw std::domain_error("Could not compute the modular inverse - numbers are not coprime");
+    }
+
+    return static_cast<uint64_t>((old_coefficient % static_cast<int64_t>(modulus) + static_cast<int64_t>(modulus)) % static_cast<int64_t>(modulus));
+}
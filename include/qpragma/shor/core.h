@@ -29,24 +29,148 @@
 #define QPRAGMA_SHOR_CORE_H
 
 #include <cmath>
-#include <random>
+#include <deque>
+#include <chrono>
+#include <span>
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <algorithm>
 #include <cstdint>
+#include <optional>
 
 #include "qpragma.h"
+#include "qpragma/shor/cache.h"
+#include "qpragma/shor/base_scheduler.h"
+#include "qpragma/shor/deadline.h"
+#include "qpragma/shor/classical.h"
+#include "qpragma/shor/trace.h"
 #include "qpragma/shor/display.h"
+#include "qpragma/shor/multiplier.h"
 #include "qpragma/shor/fraction.h"
 #include "qpragma/shor/continued_fraction.h"
+#include "qpragma/shor/post_processing.h"
+#include "qpragma/shor/lattice.h"
+#include "qpragma/shor/squaring_chain.h"
+#include "qpragma/shor/compiled_modulus.h"
+#include "qpragma/shor/emulator.h"
 
 
 namespace qpragma::shor {
+    /**
+     * Options of the "find_divisor" function
+     *  - quantum_only: ignore cases where a solution is found classically
+     *  - cache: persistent cache consulted before opening a quantum scope (optional)
+     *  - trace: trace recording each attempt, used to replay the classical part (optional)
+     *  - time_budget: maximal duration of the factorization (optional)
+     *  - seed: seed of the random streams used to draw bases (see "qpragma/shor/base_scheduler.h")
+     *  - shots: number of measurements sampled per base. Several shots are sampled on the
+     *    statevector emulator (see "qpragma/shor/emulator.h") instead of the quantum scope
+     *  - storage: storage of the amplitudes of the statevector emulator, in memory or out-of-core
+     *  - engine: engine executing the kernels of the statevector emulator
+     *  - classical_threshold: orders modulo numbers lower than this threshold are computed by the
+     *    classical order finder, which is faster than the quantum part (0 disables this fast path,
+     *    which is never used with "quantum_only")
+     *  - validate: check that the orders found by the post-processing are minimal using powers
+     *    computed independently (see "validate_order"), std::logic_error is thrown otherwise
+     *  - exponent_bits: number of exponent bits of a run (0 means 2 * SIZE). Runs using fewer bits
+     *    (at least SIZE + 1) are combined by the lattice post-processing (see
+     *    "qpragma/shor/lattice.h"), such attempts are not recorded in traces
+     *  - session: session of the statevector emulator, which can be shared by several
+     *    factorizations (optional, "storage" and "engine" are then ignored). Giving a session
+     *    selects the emulator mode, even with a single shot: phase estimations are emulated
+     *    analytically on this session, the quantum scope and the MULTIPLIER policy are not used.
+     *    The session only saves the allocations of the emulator, the rest of an attempt is
+     *    unchanged. Without session, a factorization using several shots runs in emulator mode
+     *    on a new session, and a factorization using a single shot opens quantum scopes
+     */
+    struct find_options {
+        bool quantum_only = false;
+        order_cache * cache = nullptr;
+        trace_writer * trace = nullptr;
+        std::optional<std::chrono::milliseconds> time_budget = std::nullopt;
+        uint64_t seed = 1234UL;
+        uint64_t shots = 1UL;
+        storage_options storage = storage_options();
+        engine_options engine = engine_options();
+        uint64_t classical_threshold = 0UL;
+        bool validate = false;
+        uint64_t exponent_bits = 0UL;
+        std::shared_ptr<emulator_session> session = nullptr;
+    };
+
+
+    /**
+     * Status of a factorization
+     *  - found: a non-trivial divisor has been found
+     *  - partial: the deadline expired before a divisor is found
+     *  - exhausted: all the attempts failed
+     */
+    enum class divisor_status { found, partial, exhausted };
+
+
+    /**
+     * Result of a factorization
+     * On success, "factors" contains at least two factors whose product is N. Otherwise, "factors"
+     * contains the factors found so far (if any) and "ruled_out_bases" the bases which can not
+     * lead to a divisor
+     */
+    struct divisor_result {
+        divisor_status status = divisor_status::exhausted;
+        std::vector<uint64_t> factors;
+        std::vector<uint64_t> ruled_out_bases;
+        uint64_t attempts = 0UL;
+    };
+
+
+    /**
+     * Quantum part of Shor algorithm
+     * Execute the (semi-classical) quantum phase estimation of the multiplication by
+     * "base" modulo N, and return the measurement ("nb_bits" bits, 2 * SIZE by default). A
+     * measurement holds at most "max_measured_bits" bits, longer chains throw a std::out_of_range
+     *
+     * The controlled modular multiplication is provided by the MULTIPLIER policy (see
+     * "qpragma/shor/multiplier.h"), the one provided by Q-Pragma is used by default
+     */
+    template <uint64_t SIZE, typename MULTIPLIER = qpragma_multiplier>
+    uint64_t measure_phase(uint64_t /* base */, uint64_t /* N_value */, uint64_t /* nb_bits */ = 2UL * SIZE);
+
+    template <uint64_t SIZE, typename MULTIPLIER = qpragma_multiplier>
+    uint64_t measure_phase(std::span<const chain_step> /* chain */, uint64_t /* N_value */);  // Precomputed squaring chain
+
+
     /**
      * Given a uint64_t, find a divisor.
      *
      * This function is templated by the size of then quantum register used to find
-     * a solution to this problem.
+     * a solution to this problem, and by the modular multiplier used by the quantum part.
      */
-    template <uint64_t SIZE>
+    template <uint64_t SIZE, typename MULTIPLIER = qpragma_multiplier>
+    uint64_t find_divisor(const uint64_t& /* to_divide */, const find_options & /* options */);
+
+    template <uint64_t SIZE, typename MULTIPLIER = qpragma_multiplier>
     uint64_t find_divisor(const uint64_t& /* to_divide */, const bool& /* quantum_only */ = false);
+
+
+    /**
+     * Given a number known at compile time, find a divisor.
+     *
+     * The classical part is replaced by tables computed at compile time (see
+     * "qpragma/shor/compiled_modulus.h"): only the quantum part, the continued fraction of the
+     * measurements and table lookups are executed at runtime. The cache is not used
+     */
+    template <uint64_t SIZE, uint64_t N_VALUE, typename MULTIPLIER = qpragma_multiplier>
+    uint64_t find_divisor(const find_options & /* options */ = find_options());
+
+
+    /**
+     * Given a uint64_t, find its factors.
+     *
+     * Same as "find_divisor", but a structured result is returned: this result contains every
+     * factor found, or the partial result if the time budget expires
+     */
+    template <uint64_t SIZE, typename MULTIPLIER = qpragma_multiplier>
+    divisor_result find_factors(const uint64_t& /* to_divide */, const find_options & /* options */);
 }
 
 #include "qpragma/shor/core.ipp"
@@ -4,98 +4,374 @@
  * This file provide an implementation of Shor's algorithm
  */
 
-// Function to compute b^(2^e) % m using exponentiation by squaring
-uint64_t mod_exp(uint64_t base, uint64_t exponent, const uint64_t& modulus) {
-    uint64_t result = base % modulus;
-    
-    for (uint64_t i = 0; i < exponent; ++i) 
-        result = (result * result) % modulus;
+template <uint64_t SIZE, typename MULTIPLIER>
+uint64_t qpragma::shor::measure_phase(uint64_t random_number, uint64_t to_divide, uint64_t nb_bits) {
+    return measure_phase<SIZE, MULTIPLIER>(squaring_chain(random_number, nb_bits, to_divide), to_divide);
+}
 
-    return result;
+template <uint64_t SIZE, typename MULTIPLIER>
+uint64_t qpragma::shor::measure_phase(std::span<const chain_step> chain, uint64_t to_divide) {
+    // Constants of the controlled multiplications are known before the quantum execution:
+    //  - a multiplication by 1 is the identity, it is not applied
+    //  - a circuit is synthesized once per distinct constant, repeated constants reuse it
+    // (the same plan is walked by "estimate_resources")
+    if (chain.size() > max_measured_bits) {
+        throw std::out_of_range("Could not measure the phase - measurements of more than 63 bits");
+    }
+
+    auto plan = plan_circuits(chain);
+    std::deque<typename MULTIPLIER::template circuit<SIZE>> circuits;
+    std::vector<uint64_t> circuit_indexes = plan.indexes;
+
+    for (uint64_t constant: plan.constants) {
+        circuits.emplace_back(constant, to_divide);
+    }
+
+    // Execute the quantum phase estimation, using a single control qubit (measured and
+    // reset after each controlled multiplication)
+    uint64_t measurement = 0UL;
+
+    #pragma quantum scope with(chain, circuits, circuit_indexes, measurement)
+    {
+        qpragma::qbool control;
+        qpragma::quint_t<SIZE> reg = 1UL;
+
+        for (uint64_t idx = 0UL; idx < chain.size(); ++ idx) {
+            // Leading identities always measure 0 (H PH(0) H = I): the control qubit is not used
+            if (not uses_control(chain[idx], measurement)) {
+                continue;
+            }
+
+            // Apply gates
+            qpragma::H(control);
+
+            if (not chain[idx].identity) {
+                #pragma quantum ctrl(control)
+                circuits[circuit_indexes[idx]](reg);
+            }
+
+            double angle = correction_angle(measurement, idx);
+            (qpragma::PH(angle))(control);
+            qpragma::H(control);
+
+            // Update measurement
+            if (qpragma::measure_and_reset(control)) {
+                measurement += 1UL << idx;
+            }
+        }
+
+        qpragma::reset(reg);
+    }
+
+    return measurement;
 }
 
-template <uint64_t SIZE>
+template <uint64_t SIZE, typename MULTIPLIER>
 uint64_t qpragma::shor::find_divisor(const uint64_t& to_divide, const bool& quantum_only) {
+    return find_divisor<SIZE, MULTIPLIER>(to_divide, find_options { .quantum_only = quantum_only });
+}
+
+template <uint64_t SIZE, typename MULTIPLIER>
+uint64_t qpragma::shor::find_divisor(const uint64_t& to_divide, const find_options& options) {
+    auto result = find_factors<SIZE, MULTIPLIER>(to_divide, options);
+    return result.factors.empty() ? 0UL : result.factors.front();
+}
+
+template <uint64_t SIZE, uint64_t N_VALUE, typename MULTIPLIER>
+uint64_t qpragma::shor::find_divisor(const find_options& options) {
+    if constexpr (N_VALUE % 2UL == 0UL) {
+        return 2UL;
+    }
+
+    else {
+        using tables = qpragma::shor::compiled_modulus<SIZE, N_VALUE>;
+
+        const qpragma::shor::deadline limit = options.time_budget ? qpragma::shor::deadline(*options.time_budget) : qpragma::shor::deadline();
+        qpragma::shor::attempt_budget budget(1e-3, qpragma::shor::estimate_prime_factors(N_VALUE));
+        qpragma::shor::base_scheduler scheduler(N_VALUE, options.seed);
+
+        while (not budget.exhausted() and not limit.expired()) {
+            auto next_base = scheduler.next();
+
+            if (not next_base) {
+                break;
+            }
+
+            uint64_t random_number = *next_base;
+
+            // The squaring chain is read from the tables, the quantum part is the only computation
+            uint64_t measurement = 0UL;
+
+            if (tables::gcds[random_number] == 1UL) {
+                measurement = measure_phase<SIZE, MULTIPLIER>(tables::chains[random_number], N_VALUE);
+            }
+
+            auto attempt = tables::post_process(measurement, random_number);
+            budget.record(attempt.outcome);
+
+            if (options.trace != nullptr) {
+                options.trace->write({ N_VALUE, SIZE, tables::nb_bits, random_number, measurement, attempt.outcome });
+            }
+
+            if (attempt.outcome == qpragma::shor::attempt_outcome::classical_gcd and options.quantum_only) {
+                continue;
+            }
+
+            if (not attempt.factors.empty()) {
+                return attempt.factors.front();
+            }
+        }
+
+        return 0UL;
+    }
+}
+
+template <uint64_t SIZE, typename MULTIPLIER>
+qpragma::shor::divisor_result qpragma::shor::find_factors(const uint64_t& to_divide, const find_options& options) {
+    divisor_result result;
+    const qpragma::shor::deadline limit = options.time_budget ? qpragma::shor::deadline(*options.time_budget) : qpragma::shor::deadline();
+
     // Handle case where to_divide is even
     if(auto gcd = std::gcd(2UL, to_divide); gcd != 1UL) {
-        return 2UL;
+        result.status = divisor_status::found;
+        result.factors = { 2UL, to_divide / 2UL };
+        return result;
     }
 
-    // Shor is probabilistic - define maximum attempt
-    constexpr uint64_t max_attempt = 20UL;
-    qpragma::shor::progress_display progress_bar(max_attempt);
+    // Factors of to_divide may be already known
+    if (options.cache != nullptr) {
+        if (auto factors = options.cache->find_factors(to_divide); not factors.empty()) {
+            result.status = divisor_status::found;
+            result.factors = factors;
+            return result;
+        }
+    }
 
-    // Define random generators
-    std::mt19937 rd(1234);
-    std::uniform_int_distribution<uint64_t> distrib(2UL, to_divide - 1UL);
+    // Shor is probabilistic - the number of attempts is adapted using the number of prime
+    // factors of to_divide and the observed failure modes
+    qpragma::shor::attempt_budget budget(1e-3, qpragma::shor::estimate_prime_factors(to_divide));
+    qpragma::shor::progress_display progress_bar(budget.maximum());
 
-    for (uint64_t attempt_idx = 0UL; attempt_idx < max_attempt; ++attempt_idx) {
-        // Update progress bar
-        ++progress_bar;
+    // Factors found by ignored attempts, returned if the deadline expires
+    std::vector<uint64_t> known_factors = { to_divide };
 
-        // Step 1: find a random number
-        uint64_t random_number = distrib(rd);
+    // Duration of the quantum attempts, used to switch to a cheaper engine when the deadline approaches
+    std::chrono::steady_clock::duration quantum_time {};
+    uint64_t nb_quantum_attempts = 0UL;
+
+    // Bases are never repeated, each attempt draws its base from its own random stream
+    qpragma::shor::base_scheduler scheduler(to_divide, options.seed);
+
+    // Exponent bits of a run: shorter runs are combined by the lattice post-processing
+    const uint64_t nb_bits = options.exponent_bits != 0UL ? options.exponent_bits : 2UL * SIZE;
+    const uint64_t nb_runs = options.exponent_bits != 0UL ? qpragma::shor::lattice_runs(SIZE, nb_bits) : 1UL;
+
+    // Buffers and threads of the statevector emulator are kept alive across attempts
+    std::shared_ptr<qpragma::shor::emulator_session> session = options.session;
+
+    if (not session and options.shots > 1UL) {
+        session = std::make_shared<qpragma::shor::emulator_session>(options.storage, options.engine);
+    }
+
+    while (not budget.exhausted()) {
+        if (limit.expired()) {
+            result.status = divisor_status::partial;
+            break;
+        }
+
+        // Update progress bar (the progress is relative to the current budget)
+        progress_bar.advance_to((budget.attempts() + 1UL) * budget.maximum() / budget.total());
+
+        // Step 1: find a random number (stop if all the bases were tried)
+        auto next_base = scheduler.next();
+
+        if (not next_base) {
+            break;
+        }
+
+        uint64_t random_number = *next_base;
 
         // If random_number is not coprime with to_divide, gcd is a solution
         if(auto gcd = std::gcd(random_number, to_divide); gcd != 1UL) {
-            if (quantum_only) 
+            budget.record(qpragma::shor::attempt_outcome::classical_gcd);
+
+            if (options.trace != nullptr) {
+                options.trace->write({ to_divide, SIZE, 2UL * SIZE, random_number, 0UL, qpragma::shor::attempt_outcome::classical_gcd });
+            }
+
+            if (options.quantum_only) {
+                qpragma::shor::refine_factors(known_factors, gcd);
                 continue;
-            return gcd;
+            }
+
+            result.status = divisor_status::found;
+            result.factors = { gcd, to_divide / gcd };
+            break;
         }
 
-        // Step 2: Perform quantum part
-        // Execute the quantum phase estimation
-        uint64_t measurement = 0UL;
+        // The order of random_number may be already known
+        if (options.cache != nullptr) {
+            if (auto order = options.cache->find_order(random_number, to_divide)) {
+                auto attempt = qpragma::shor::process_order(random_number, *order, to_divide, limit);
 
-        #pragma quantum scope with(random_number, to_divide, measurement)
-        {
-            qpragma::qbool control;
-            qpragma::quint_t<SIZE> reg = 1UL;
+                if (attempt.interrupted) {
+                    result.status = divisor_status::partial;
+                    break;
+                }
 
-            for (uint64_t idx = 0UL; idx < 2UL * SIZE; ++ idx) {
-                uint64_t base = mod_exp(random_number, 2UL * SIZE - 1UL - idx, to_divide);
+                budget.record(attempt.outcome);
 
-                // Apply gates
-                qpragma::H(control);
+                if (attempt.outcome == qpragma::shor::attempt_outcome::success) {
+                    options.cache->store_factors(to_divide, attempt.factors);
+                    result.status = divisor_status::found;
+                    result.factors = attempt.factors;
+                    break;
+                }
 
-                #pragma quantum ctrl(control)
-                qpragma::arith::mult_const_mod_in_place<SIZE>(base, to_divide)(reg);
+                result.ruled_out_bases.push_back(random_number);
+                continue;
+            }
+        }
+
+        // Small numbers: the order is computed classically, faster than the quantum part
+        if (not options.quantum_only and to_divide < options.classical_threshold) {
+            uint64_t order = qpragma::shor::classical_order(random_number, to_divide, limit);
+            auto attempt = qpragma::shor::process_order(random_number, order, to_divide, limit);
+
+            if (attempt.interrupted) {
+                result.status = divisor_status::partial;
+                break;
+            }
+
+            budget.record(attempt.outcome);
 
-                double angle = - 2 * M_PI * static_cast<double>(measurement) / static_cast<double>(1UL << idx);
-                (qpragma::PH(angle))(control);
-                qpragma::H(control);
+            if (options.cache != nullptr and order != 0UL) {
+                options.cache->store_order(random_number, to_divide, order);
+            }
 
-                // Update measurement
-                if (qpragma::measure_and_reset(control)) {
-                    measurement += 1 << idx;
+            if (attempt.outcome == qpragma::shor::attempt_outcome::success) {
+                if (options.cache != nullptr) {
+                    options.cache->store_factors(to_divide, attempt.factors);
                 }
+
+                result.status = divisor_status::found;
+                result.factors = attempt.factors;
+                break;
+            }
+
+            if (order != 0UL) {
+                result.ruled_out_bases.push_back(random_number);
+            }
+
+            continue;
+        }
+
+        // The next quantum attempt would not end before the deadline: prefer a cheaper engine
+        if (
+            not options.quantum_only and nb_quantum_attempts != 0UL
+            and limit.remaining() < quantum_time / nb_quantum_attempts
+        ) {
+            if (auto divisor = qpragma::shor::trial_division(to_divide, limit); divisor != 0UL) {
+                result.status = divisor_status::found;
+                result.factors = { divisor, to_divide / divisor };
+            }
+
+            else if (limit.expired()) {
+                result.status = divisor_status::partial;
             }
 
-            qpragma::reset(reg);
+            break;
+        }
+
+        // Step 2: Perform quantum part
+        // Execute the quantum phase estimation (shots are sampled on the session of the
+        // statevector emulator, sharing the emulation of their common prefixes). An attempt is
+        // made of "nb_runs" runs
+        auto start = std::chrono::steady_clock::now();
+        auto chain = squaring_chain(random_number, nb_bits, to_divide);
+        std::vector<uint64_t> measurements;
+
+        if (session) {
+            // Shots of a base use their own stream (keyed by the base, and distinct from the streams of the scheduler)
+            qpragma::shor::random_stream stream(~options.seed, to_divide, random_number);
+            measurements = qpragma::shor::sample_phases(chain, to_divide, SIZE, options.shots * nb_runs, stream, session);
+        }
+
+        else {
+            for (uint64_t run = 0UL; run < nb_runs; ++run) {
+                measurements.push_back(measure_phase<SIZE, MULTIPLIER>(chain, to_divide));
+            }
         }
 
+        quantum_time += std::chrono::steady_clock::now() - start;
+        ++nb_quantum_attempts;
+
         // Step 3: classical part
-        qpragma::shor::fraction frac(measurement, 1UL << (2UL * SIZE));
-        auto candidate = qpragma::shor::find_candidate(frac, random_number, to_divide);  // If no candidate, 0UL is returned
-
-        if (candidate != 0UL) {
-            auto pow_value = pow_mod(random_number, candidate / 2UL, to_divide);
-
-            // The following equality is true "(pow_value + 1) * (pow_value - 1) % to_divide == 0", but:
-            //
-            //   - If a non-trival divisor can be computed from "pow_value + 1", a non-trivial divisor can be also computed
-            //     from "pow_value - 1".
-            //   - If only a trivial divisor can be computed from "pow_value + 1", only a trivial divisor can be computed
-            //     from "pow_value - 1".
-            //
-            // Then, only "pow_value + 1" will be considered to find a divisor.
-            if (auto value = std::gcd(pow_value + 1UL, to_divide); value != 1 and value != to_divide) {
-                progress_bar += max_attempt - attempt_idx - 1UL;
-                return value;
+        // Both "a^(r/2) ± 1" are tried and the order is reused to split the cofactors
+        for (uint64_t first = 0UL; first < measurements.size(); first += nb_runs) {
+            auto attempt = nb_runs == 1UL
+                ? qpragma::shor::post_process(measurements[first], nb_bits, random_number, to_divide, limit)
+                : qpragma::shor::post_process_runs(
+                    std::span<const uint64_t>(measurements).subspan(first, nb_runs), nb_bits, random_number, to_divide, limit
+                );
+
+            // The deadline expired during the post-processing: the attempt is not a failure
+            // (it is neither recorded in the budget, nor in the trace or the cache)
+            if (attempt.interrupted) {
+                result.status = divisor_status::partial;
+                break;
+            }
+
+            budget.record(attempt.outcome);
+
+            if (options.validate and attempt.order != 0UL) {
+                qpragma::shor::validate_order(random_number, attempt.order, to_divide, limit);
+            }
+
+            // Entries of a trace describe attempts made of a single run
+            if (options.trace != nullptr and nb_runs == 1UL) {
+                options.trace->write({ to_divide, SIZE, nb_bits, random_number, measurements[first], attempt.outcome });
+            }
+
+            if (options.cache != nullptr and attempt.order != 0UL) {
+                options.cache->store_order(random_number, to_divide, attempt.order);
+            }
+
+            if (attempt.outcome == qpragma::shor::attempt_outcome::success) {
+                if (options.cache != nullptr) {
+                    options.cache->store_factors(to_divide, attempt.factors);
+                }
+
+                result.status = divisor_status::found;
+                result.factors = attempt.factors;
+                break;
+            }
+
+            // A base having an odd order (or giving only trivial divisors) is useless: remaining
+            // shots of this base are skipped
+            if (
+                attempt.outcome == qpragma::shor::attempt_outcome::odd_order
+                or attempt.outcome == qpragma::shor::attempt_outcome::trivial_split
+            ) {
+                result.ruled_out_bases.push_back(random_number);
+                break;
             }
         }
+
+        if (result.status != divisor_status::exhausted) {
+            break;
+        }
+    }
+
+    if (result.status == divisor_status::found) {
+        progress_bar.advance_to(budget.maximum());
     }
 
-    // No divisor found
-    return 0UL;
+    else if (result.status == divisor_status::partial and known_factors.size() > 1UL) {
+        std::ranges::sort(known_factors);
+        result.factors = known_factors;
+    }
+
+    result.attempts = budget.attempts();
+    return result;
 }
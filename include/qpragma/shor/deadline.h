@@ -0,0 +1,58 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/deadline.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Deadline of a factorization
+ */
+
+#ifndef QPRAGMA_SHOR_DEADLINE_H
+#define QPRAGMA_SHOR_DEADLINE_H
+
+#include <chrono>
+#include <optional>
+
+
+namespace qpragma::shor {
+    /**
+     * Deadline
+     * A deadline is either a point in time or infinite (default). Long loops check
+     * this deadline regularly and stop once it has expired
+     */
+    class deadline {
+    public:
+        using clock = std::chrono::steady_clock;
+
+    private:
+        std::optional<clock::time_point> _end;
+
+    public:
+        deadline() = default;
+        explicit deadline(std::chrono::milliseconds /* time_budget */);
+
+        bool is_infinite() const;
+        bool expired() const;
+        std::chrono::milliseconds remaining() const;  // Maximal duration if infinite
+    };
+}
+
+#endif  /* QPRAGMA_SHOR_DEADLINE_H */
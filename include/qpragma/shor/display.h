@@ -25,7 +25,7 @@
 #ifndef QPRAGMA_SHOR_DISPLAY_H
 #define QPRAGMA_SHOR_DISPLAY_H
 
-#include <list>
+#include <vector>
 #include <ostream>
 #include <cstdint>
 #include <boost/timer/progress_display.hpp>
@@ -36,7 +36,7 @@ namespace qpragma::shor {
      * Display in a pretty way a continued fraction
      * representation
      */
-    void pretty_display(const std::list<int64_t> & /* continued_fraction */);
+    void pretty_display(const std::vector<int64_t> & /* continued_fraction */);
 
 
     /**
@@ -50,6 +50,9 @@ namespace qpragma::shor {
         progress_display(const progress_display &) = delete;
         progress_display & operator=(const progress_display &) = delete;
 
+        // Advance the progress bar up to a given count (never goes backward)
+        void advance_to(uint64_t /* target_count */);
+
         // Destructor
         ~progress_display();
     };
@@ -58,8 +61,8 @@ namespace qpragma::shor {
 
 /**
  * Display a continued fraction representation
- * This operator displays a list
+ * This operator displays a vector
  */
-std::ostream & operator<<(std::ostream &, const std::list<int64_t> &);
+std::ostream & operator<<(std::ostream &, const std::vector<int64_t> &);
 
 #endif  /* QPRAGMA_SHOR_DISPLAY_H */
@@ -0,0 +1,186 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/emulator.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Statevector emulator of the phase estimation, used to sample several measurements per base
+ */
+
+#ifndef QPRAGMA_SHOR_EMULATOR_H
+#define QPRAGMA_SHOR_EMULATOR_H
+
+#include <span>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "qpragma/shor/storage.h"
+#include "qpragma/shor/engine.h"
+#include "qpragma/shor/squaring_chain.h"
+#include "qpragma/shor/base_scheduler.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Largest register of the statevector emulator, in qubits: 2^39 amplitudes (8 TiB) in
+     * memory, 2^47 amplitudes in memory-mapped files. A measurement holds at most 63 bits
+     * (see "max_measured_bits"): registers above 31 qubits can only be sampled using shorter
+     * runs (see "find_options::exponent_bits")
+     */
+    constexpr uint64_t max_register_size(storage_backend backend) {
+        return backend == storage_backend::mapped ? 47UL : 39UL;
+    }
+
+
+    /**
+     * Session of the statevector emulator, reused across attempts (and factorizations)
+     * A session keeps its engine (and the threads of this engine) alive and recycles the storages
+     * released by the statevectors: a new statevector only resets the amplitudes of a recycled
+     * storage instead of allocating (and mapping) a new one. At most "max_released" storages are
+     * kept, further released storages are freed (by default, a statevector and its scratch
+     * storage are kept: the storages of a single-shot attempt are reused by the next one)
+     *
+     * A session is not thread-safe, concurrent factorizations use their own session
+     */
+    class emulator_session {
+    public:
+        // Constructors (non-copyable)
+        explicit emulator_session(
+            const storage_options & /* storage */ = storage_options(), const engine_options & /* engine */ = engine_options(),
+            uint64_t /* max_released */ = 2UL
+        );
+        emulator_session(const storage_options & /* storage */, std::shared_ptr<statevector_engine> /* engine */, uint64_t /* max_released */ = 2UL);
+        emulator_session(const emulator_session &) = delete;
+        emulator_session & operator=(const emulator_session &) = delete;
+
+        const storage_options & storage() const;
+        statevector_engine & engine() const;
+
+        // Number of storages allocated by the session (recycled storages are not counted)
+        uint64_t nb_allocations() const;
+
+        // Number of released storages kept by the session
+        uint64_t nb_released() const;
+
+        // Storage of "size" amplitudes initialized to zero
+        std::unique_ptr<amplitude_storage> zeros(uint64_t /* size */);
+
+        // Copy of a storage
+        std::unique_ptr<amplitude_storage> copy(const amplitude_storage & /* input */);
+
+        // Storage of "size" amplitudes, its amplitudes are left unspecified
+        std::unique_ptr<amplitude_storage> scratch(uint64_t /* size */);
+
+        // Give a storage back to the session
+        void release(std::unique_ptr<amplitude_storage> /* storage */);
+
+    private:
+        storage_options _storage;
+        std::shared_ptr<statevector_engine> _engine;
+        std::vector<std::unique_ptr<amplitude_storage>> _released;
+        uint64_t _max_released;
+        uint64_t _nb_allocations;
+
+        // Recycled storage of "size" amplitudes (nullptr if there is none)
+        std::unique_ptr<amplitude_storage> _recycle(uint64_t /* size */);
+    };
+
+
+    /**
+     * Statevector of the quantum register of the phase estimation
+     * Ancillas of the controlled multiplications are always reset: the multiplication by a
+     * constant "a" is the permutation x -> a x mod N (basis states x >= N are unchanged).
+     * The control qubit is not stored, each step "H, ctrl(U), PH(angle), H" followed by the
+     * measurement of the control qubit is computed analytically:
+     *  - outcome 0 (resp. 1) leaves the register in (psi + e^(i angle) U psi) / 2 (resp. "-")
+     *  - the probability of an outcome is the squared norm of this state
+     *
+     * Amplitudes are stored by storages (see "qpragma/shor/storage.h") taken from a session and
+     * each step is computed by the kernels of the engine of this session (see
+     * "qpragma/shor/engine.h"). A projection writes into a second storage, both storages are
+     * swapped and reused by the next projections. A projection written in a new state only uses
+     * one storage. Storages are given back to the session when the statevector is destroyed
+     */
+    class statevector {
+    public:
+        // Constructor (register initialized to |1>)
+        explicit statevector(uint64_t /* size */, std::shared_ptr<emulator_session> /* session */ = std::make_shared<emulator_session>());
+        statevector(const statevector &);
+        statevector(statevector &&) noexcept;
+        statevector & operator=(const statevector &);
+        statevector & operator=(statevector &&) noexcept;
+        ~statevector();
+
+        uint64_t size() const;
+        std::span<const amplitude> amplitudes() const;
+
+        // Probability of measuring 0 on the control qubit
+        double probability(const chain_step & /* step */, uint64_t /* N_value */, double /* angle */) const;
+
+        // Project the register on the measured outcome (of probability "probability")
+        void project(const chain_step & /* step */, uint64_t /* N_value */, double /* angle */, bool /* outcome */, double /* probability */);
+
+        // Projection of the register on an outcome, written in a new state (this state is unchanged)
+        statevector projection(const chain_step & /* step */, uint64_t /* N_value */, double /* angle */, bool /* outcome */, double /* probability */) const;
+
+    private:
+        uint64_t _size;
+        std::shared_ptr<emulator_session> _session;
+        std::unique_ptr<amplitude_storage> _storage;
+        std::unique_ptr<amplitude_storage> _scratch;
+
+        statevector(uint64_t /* size */, std::shared_ptr<emulator_session> /* session */, std::unique_ptr<amplitude_storage> /* storage */);
+
+        // Write the projection on an outcome in "output"
+        void _combine(
+            const chain_step & /* step */, uint64_t /* N_value */, double /* angle */, bool /* outcome */,
+            double /* probability */, amplitude_storage & /* output */
+        ) const;
+    };
+
+
+    /**
+     * Sample several measurements of the phase estimation
+     * Shots are sampled as a tree: at each step, the probability of both outcomes is computed
+     * once and the shots are split between these outcomes. Only when shots diverge, the state of
+     * the shots measuring 1 is projected in a new state (a pending state holds a single storage),
+     * so shots sharing their first bits share the emulation of these bits
+     *
+     * Returns "nb_shots" measurements (one bit per step of the chain, longer chains than
+     * "max_measured_bits" throw a std::out_of_range), shuffled using the stream: the leaves
+     * of the tree are reached one after the other, consecutive measurements are independent once
+     * shuffled (they can be grouped in runs, see "qpragma/shor/lattice.h")
+     */
+    std::vector<uint64_t> sample_phases(
+        std::span<const chain_step> /* chain */, uint64_t /* N_value */, uint64_t /* size */, uint64_t /* nb_shots */,
+        random_stream & /* stream */, const std::shared_ptr<emulator_session> & /* session */
+    );
+
+    // Sample several measurements using a new session
+    std::vector<uint64_t> sample_phases(
+        std::span<const chain_step> /* chain */, uint64_t /* N_value */, uint64_t /* size */, uint64_t /* nb_shots */,
+        random_stream & /* stream */, const storage_options & /* storage */ = storage_options(),
+        const engine_options & /* engine */ = engine_options()
+    );
+}
+
+#endif  /* QPRAGMA_SHOR_EMULATOR_H */
@@ -0,0 +1,213 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/engine.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Kernels of the statevector emulator: sequential reference kernels and multithreaded kernels
+ */
+
+#ifndef QPRAGMA_SHOR_ENGINE_H
+#define QPRAGMA_SHOR_ENGINE_H
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "qpragma/shor/storage.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Engine executing the kernels
+     *  - reference: sequential kernels
+     *  - parallel: multithreaded and cache-blocked kernels
+     */
+    enum class emulator_engine { reference, parallel };
+
+
+    /**
+     * Options of the engine
+     *  - engine: engine executing the kernels
+     *  - nb_threads: number of threads of the parallel engine (0 means one per hardware thread)
+     *  - tile_size: number of amplitudes of a tile of the parallel engine. A tile, the amplitudes
+     *    it gathers and its output should fit in the L2 cache
+     */
+    struct engine_options {
+        emulator_engine engine = emulator_engine::reference;
+        uint64_t nb_threads = 0UL;
+        uint64_t tile_size = 1UL << 12UL;
+    };
+
+
+    /**
+     * Pool of threads executing a function on all its threads
+     * The calling thread is the thread 0 of the pool. If the function throws on some threads,
+     * "run" rethrows the first exception once every thread is done
+     */
+    class thread_pool {
+    private:
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _start;
+        std::condition_variable _done;
+        const std::function<void(uint64_t)> * _function = nullptr;
+        std::exception_ptr _error;
+        uint64_t _generation = 0UL;
+        uint64_t _nb_running = 0UL;
+        bool _stop = false;
+
+        void _work(uint64_t /* thread_idx */);
+
+    public:
+        // Constructor (non-copyable)
+        explicit thread_pool(uint64_t /* nb_threads */);
+        thread_pool(const thread_pool &) = delete;
+        thread_pool & operator=(const thread_pool &) = delete;
+
+        // Destructor
+        ~thread_pool();
+
+        // Execute "function(thread_idx)" on each thread, returns when every thread is done
+        uint64_t size() const;
+        void run(const std::function<void(uint64_t)> & /* function */);
+    };
+
+
+    /**
+     * Thread prefetching the blocks of out-of-core storages
+     * One task is pending at most: "submit" starts it, "wait" returns when it is done and rethrows
+     * its exception. The thread is created by the first task and reused by the next ones
+     */
+    class prefetch_thread {
+    private:
+        std::thread _worker;
+        std::mutex _mutex;
+        std::condition_variable _start;
+        std::condition_variable _done;
+        std::function<void()> _task;
+        std::exception_ptr _error;
+        bool _pending = false;
+        bool _stop = false;
+
+        void _work();
+
+    public:
+        // Constructor (non-copyable)
+        prefetch_thread() = default;
+        prefetch_thread(const prefetch_thread &) = delete;
+        prefetch_thread & operator=(const prefetch_thread &) = delete;
+
+        // Destructor
+        ~prefetch_thread();
+
+        // Start a task (the previous one must be done), wait for the pending task
+        void submit(std::function<void()> /* task */);
+        void wait();
+    };
+
+
+    /**
+     * Kernels of a step of the phase estimation (see "qpragma/shor/emulator.h")
+     * The controlled multiplication by "a" is the permutation U: x -> a x mod N, kernels are given
+     * "inverse" = a^(-1) mod N since (U psi)[y] = psi[inverse y mod N] for y < N. The Hadamard and
+     * phase gates of the control qubit are folded in the complex factor "phase"
+     *
+     * Out-of-core storages are streamed block per block, once per kernel: the next block is
+     * prefetched by the thread of the engine. An engine is used by one thread at a time
+     */
+    class statevector_engine {
+    protected:
+        prefetch_thread _prefetch;
+
+    public:
+        virtual ~statevector_engine() = default;
+
+        // Set every amplitude to zero
+        virtual void fill_zeros(amplitude_storage & /* output */);
+
+        // Copy the amplitudes of a storage into another storage of the same size
+        virtual void copy(const amplitude_storage & /* input */, amplitude_storage & /* output */);
+
+        // Squared norm of "psi + phase U psi"
+        virtual double norm(
+            const amplitude_storage & /* input */, uint64_t /* inverse */, uint64_t /* N_value */, amplitude /* phase */
+        ) = 0;
+
+        // output = (psi + phase U psi) * scale (every amplitude of the output is written)
+        virtual void combine(
+            const amplitude_storage & /* input */, amplitude_storage & /* output */,
+            uint64_t /* inverse */, uint64_t /* N_value */, amplitude /* phase */, double /* scale */
+        ) = 0;
+    };
+
+
+    /**
+     * Sequential reference engine
+     */
+    class reference_engine: public statevector_engine {
+    public:
+        double norm(const amplitude_storage &, uint64_t, uint64_t, amplitude) override;
+        void combine(const amplitude_storage &, amplitude_storage &, uint64_t, uint64_t, amplitude, double) override;
+    };
+
+
+    /**
+     * Multithreaded engine
+     * Each block is split in tiles, threads process contiguous ranges of tiles. A tile is computed
+     * in two passes: the amplitudes it gathers are copied in a buffer of the thread (the only
+     * irregular accesses), then the tile is combined with the buffer by a vectorized kernel
+     * (OpenMP SIMD directives, vectorized by release builds).
+     *
+     * Amplitudes in memory are allocated without being touched: they are first written by the
+     * thread processing them (zeros and copies are written by the threads too), which places
+     * them on its NUMA node. The partition of the register only depends on its size, so each
+     * thread always processes the amplitudes it placed
+     */
+    class parallel_engine: public statevector_engine {
+    private:
+        thread_pool _pool;
+        uint64_t _tile_size;
+        std::vector<std::vector<amplitude>> _buffers;
+
+        // Execute "function(first, last)" on the tiles of [first, last) handled by each thread
+        void _parallel_for(uint64_t /* first */, uint64_t /* last */, const std::function<void(uint64_t, uint64_t, uint64_t)> & /* function */);
+
+    public:
+        explicit parallel_engine(const engine_options & /* options */);
+
+        void fill_zeros(amplitude_storage &) override;
+        void copy(const amplitude_storage &, amplitude_storage &) override;
+        double norm(const amplitude_storage &, uint64_t, uint64_t, amplitude) override;
+        void combine(const amplitude_storage &, amplitude_storage &, uint64_t, uint64_t, amplitude, double) override;
+    };
+
+
+    // Create an engine
+    std::shared_ptr<statevector_engine> make_engine(const engine_options & /* options */ = engine_options());
+}
+
+#endif  /* QPRAGMA_SHOR_ENGINE_H */
@@ -44,7 +44,7 @@ namespace qpragma::shor {
      * (and q is not null)
      *
      * This class is designed to be compatible with the Continued Fraction implementation
-     * of boost
+     * of boost. Fractions can be used in constant expressions
      */
     class fraction {
     private:
@@ -52,36 +52,36 @@ namespace qpragma::shor {
         uint64_t _numerator = 0UL;
         uint64_t _denominator = 1UL;
 
-        void _simplify();
+        constexpr void _simplify();
 
     public:
-        fraction() = default;
-        explicit fraction(uint64_t /* number */, sign /* fsign */ = sign::pos);                         // Computes "± number / 1"
-        explicit fraction(int /* number */);                                                            // Computes "number / 1"
-        explicit fraction(int64_t /* number */);                                                        // Computes "number / 1"
-        fraction(uint64_t /* numerator */, uint64_t /* denominator */, sign /* fsign */ = sign::pos);   // Computes "± numerator / denominator"
+        constexpr fraction() = default;
+        constexpr explicit fraction(uint64_t /* number */, sign /* fsign */ = sign::pos);                         // Computes "± number / 1"
+        constexpr explicit fraction(int /* number */);                                                            // Computes "number / 1"
+        constexpr explicit fraction(int64_t /* number */);                                                        // Computes "number / 1"
+        constexpr fraction(uint64_t /* numerator */, uint64_t /* denominator */, sign /* fsign */ = sign::pos);   // Computes "± numerator / denominator"
 
         // Get numerator and denomirator
-        sign get_sign() const;
-        uint64_t numerator() const;
-        uint64_t denominator() const;
+        constexpr sign get_sign() const;
+        constexpr uint64_t numerator() const;
+        constexpr uint64_t denominator() const;
 
         // Cast function
-        fraction & operator=(uint64_t);
-        operator uint64_t() const;
-        operator int64_t() const;
+        constexpr fraction & operator=(uint64_t);
+        constexpr operator uint64_t() const;
+        constexpr operator int64_t() const;
 
         // Operators
-        fraction & operator+=(const fraction &);
-        fraction & operator-=(const fraction &);
-        fraction & operator*=(const fraction &);
-        std::strong_ordering operator<=>(const fraction &) const;
+        constexpr fraction & operator+=(const fraction &);
+        constexpr fraction & operator-=(const fraction &);
+        constexpr fraction & operator*=(const fraction &);
+        constexpr std::strong_ordering operator<=>(const fraction &) const;
         
-        bool operator==(int) const;
-        bool operator==(uint64_t) const;
-        bool operator==(const fraction &) const;
+        constexpr bool operator==(int) const;
+        constexpr bool operator==(uint64_t) const;
+        constexpr bool operator==(const fraction &) const;
 
-        fraction operator-() const;
+        constexpr fraction operator-() const;
     };
 }
 
@@ -93,7 +93,7 @@ namespace std {
      * The fraction is finite if and only if the denomination is different
      * that 0 (and the numerator is finite, which is always true)
      */
-    bool isfinite(const qpragma::shor::fraction &);
+    constexpr bool isfinite(const qpragma::shor::fraction &);
 
 
     /**
@@ -102,7 +102,7 @@ namespace std {
      * This function uses the "static_cast<uint64_t>" function, provided by the
      * fraction class
      */
-    qpragma::shor::fraction floor(const qpragma::shor::fraction &);
+    constexpr qpragma::shor::fraction floor(const qpragma::shor::fraction &);
 
 
     /**
@@ -110,7 +110,7 @@ namespace std {
      *
      * This function copy the argument but change the sign of the fraction
      */
-    qpragma::shor::fraction abs(const qpragma::shor::fraction &);
+    constexpr qpragma::shor::fraction abs(const qpragma::shor::fraction &);
 }
 
 
@@ -120,26 +120,28 @@ namespace std {
  */
 
 // Add
-qpragma::shor::fraction operator+(const qpragma::shor::fraction &, const qpragma::shor::fraction &);
+constexpr qpragma::shor::fraction operator+(const qpragma::shor::fraction &, const qpragma::shor::fraction &);
 
 
 // Substract
-qpragma::shor::fraction operator-(const qpragma::shor::fraction &, const qpragma::shor::fraction &);
+constexpr qpragma::shor::fraction operator-(const qpragma::shor::fraction &, const qpragma::shor::fraction &);
 
 
 // Inverse
-qpragma::shor::fraction operator/(int, const qpragma::shor::fraction &);
-qpragma::shor::fraction operator/(uint64_t, const qpragma::shor::fraction &);
-qpragma::shor::fraction operator/(const qpragma::shor::fraction &, const qpragma::shor::fraction &);
+constexpr qpragma::shor::fraction operator/(int, const qpragma::shor::fraction &);
+constexpr qpragma::shor::fraction operator/(uint64_t, const qpragma::shor::fraction &);
+constexpr qpragma::shor::fraction operator/(const qpragma::shor::fraction &, const qpragma::shor::fraction &);
 
 
 // Multiply
-qpragma::shor::fraction operator*(int, const qpragma::shor::fraction &);
-qpragma::shor::fraction operator*(uint64_t, const qpragma::shor::fraction &);
-qpragma::shor::fraction operator*(const qpragma::shor::fraction &, const qpragma::shor::fraction &);
+constexpr qpragma::shor::fraction operator*(int, const qpragma::shor::fraction &);
+constexpr qpragma::shor::fraction operator*(uint64_t, const qpragma::shor::fraction &);
+constexpr qpragma::shor::fraction operator*(const qpragma::shor::fraction &, const qpragma::shor::fraction &);
 
 
 // Display fraction
 std::ostream & operator<<(std::ostream &, const qpragma::shor::fraction &);
 
+#include "qpragma/shor/fraction.ipp"
+
 #endif  /* QPRAGMA_SHOR_FRACTION_H */
@@ -0,0 +1,72 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/lattice.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Lattice post-processing, recovering the order from several runs using fewer exponent bits
+ */
+
+#ifndef QPRAGMA_SHOR_LATTICE_H
+#define QPRAGMA_SHOR_LATTICE_H
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+#include "qpragma/shor/deadline.h"
+#include "qpragma/shor/post_processing.h"
+
+
+namespace qpragma::shor {
+    /**
+     * LLL reduction of a lattice basis
+     * The rows of "basis" are the vectors of the basis, which is reduced in place. The
+     * Gram-Schmidt orthogonalization is computed using floating point numbers (the lattices of
+     * the post-processing have a small dimension), the basis stays exact
+     */
+    void lll_reduce(std::vector<std::vector<int64_t>> & /* basis */, double /* delta */ = 0.99);
+
+
+    /**
+     * Number of runs combined by the lattice post-processing
+     * Each run measures "nb_bits" = SIZE + t exponent bits: about SIZE / t runs are needed to
+     * recover the order, one more run is used as a safety margin
+     */
+    uint64_t lattice_runs(uint64_t /* size */, uint64_t /* nb_bits */);
+
+
+    /**
+     * Post-process several runs using a lattice (see Seifert, and Ekerå)
+     * Each measurement j_i of a run using the same base is close to 2^nb_bits k_i / r. The vector
+     *   r (1, j_1, ..., j_n) - sum_i k_i 2^nb_bits e_i = (r, r j_1 - k_1 2^nb_bits, ...)
+     * is a short vector of the lattice spanned by (1, j_1, ..., j_n) and the 2^nb_bits e_i: the
+     * order is found as the first coordinate of a vector of the reduced basis
+     *
+     * Returns the result of the attempt made of these runs
+     */
+    attempt_result post_process_runs(
+        std::span<const uint64_t> /* measurements */, uint64_t /* nb_bits */, uint64_t /* base */, uint64_t /* N_value */,
+        const deadline & /* limit */ = deadline()
+    );
+}
+
+#endif  /* QPRAGMA_SHOR_LATTICE_H */
@@ -0,0 +1,264 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/multiplier.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Controlled modular multipliers used by the quantum part of Shor algorithm
+ */
+
+#ifndef QPRAGMA_SHOR_MULTIPLIER_H
+#define QPRAGMA_SHOR_MULTIPLIER_H
+
+#include <bit>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "qpragma.h"
+#include "qpragma/shor/resources.h"
+#include "qpragma/shor/continued_fraction.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Cost of a multiplier based on adders in the Fourier space (Draper adders, Beauregard
+     * modular adders). QFT rotations acting on qubits distant by "approximation" or more
+     * are dropped (if "approximation" is greater than size, the QFT is exact)
+     *
+     * A multiplication is made of two multiplications in the Fourier space (the second one
+     * uncomputes the register using the inverse of the constant) and a swap. Each one is made
+     * of n modular adders, each modular adder uses 4 QFT and 5 adders in the Fourier space
+     */
+    constexpr multiplier_cost fourier_multiplier_cost(uint64_t size, uint64_t approximation) {
+        const uint64_t nb_qubits = size + 1UL;
+        uint64_t qft_gates = 0UL;
+
+        for (uint64_t idx = 0UL; idx < nb_qubits; ++idx) {
+            qft_gates += 1UL + std::min(idx, approximation - 1UL);
+        }
+
+        const uint64_t qft_depth = 2UL * nb_qubits - 1UL;
+        const uint64_t adder_gates = 4UL * qft_gates + 5UL * nb_qubits + 4UL;
+        const uint64_t adder_depth = 4UL * qft_depth + 9UL;
+
+        return multiplier_cost {
+            .ancillas = size + 2UL,
+            .gates = 2UL * (size * adder_gates + 2UL * qft_gates) + 3UL * size,
+            .depth = 2UL * (size * adder_depth + 2UL * qft_depth) + 3UL * size
+        };
+    }
+
+
+    /**
+     * Cost of a multiplication when emulated
+     * The emulation time is proportional to the number of gates and to the size of the state
+     * vector (2^qubits amplitudes)
+     */
+    constexpr double emulation_cost(const multiplier_cost & cost, uint64_t size) {
+        double result = static_cast<double>(cost.gates);
+
+        for (uint64_t idx = 0UL; idx < 1UL + size + cost.ancillas; ++idx) {
+            result *= 2.;
+        }
+
+        return result;
+    }
+
+
+    /**
+     * Classical constants of a modular multiplication by "constant"
+     * The multiplication is made of two multiplications in the Fourier space (or using
+     * ripple-carry adders): each one adds "terms[idx]" if the qubit idx of the register is set
+     *  - forward: constant * 2^idx modulo N
+     *  - backward: - constant^(-1) * 2^idx modulo N (used to uncompute the accumulator)
+     */
+    template <uint64_t SIZE>
+    struct multiplication_terms {
+        multiplication_terms(uint64_t /* constant */, uint64_t /* N_value */);
+
+        uint64_t N_value;
+        std::array<uint64_t, SIZE> forward;
+        std::array<uint64_t, SIZE> backward;
+    };
+
+
+    /**
+     * Multiplier provided by Q-Pragma (qpragma::arith::mult_const_mod_in_place)
+     * Q-Pragma does not expose the resources used by its arithmetic: its cost is modeled by
+     * a Beauregard-like implementation using exact QFT
+     */
+    struct qpragma_multiplier {
+        static constexpr multiplier_cost cost(uint64_t size) {
+            return fourier_multiplier_cost(size, size + 1UL);
+        }
+
+        template <uint64_t SIZE>
+        using circuit = qpragma::arith::mult_const_mod_in_place<SIZE>;
+
+        template <uint64_t SIZE>
+        static void apply(uint64_t /* constant */, uint64_t /* N_value */, qpragma::quint_t<SIZE> & /* reg */);
+    };
+
+
+    /**
+     * Beauregard multiplier (2n + 3 qubits, control included)
+     * Modular adders are built using Draper adders in the Fourier space. The QFT is approximated:
+     * rotations smaller than 2π / 2^(log2(n) + 3) are dropped
+     */
+    struct draper_multiplier {
+        static constexpr uint64_t approximation(uint64_t size) {
+            return std::bit_width(size) + 2UL;
+        }
+
+        static constexpr multiplier_cost cost(uint64_t size) {
+            return fourier_multiplier_cost(size, approximation(size));
+        }
+
+        /**
+         * Circuit multiplying by a given constant
+         * Classical constants are computed once, the circuit can be applied several times
+         */
+        template <uint64_t SIZE>
+        class circuit {
+        public:
+            circuit(uint64_t /* constant */, uint64_t /* N_value */);
+            void operator()(qpragma::quint_t<SIZE> & /* reg */) const;
+
+        private:
+            multiplication_terms<SIZE> _terms;
+        };
+
+        template <uint64_t SIZE>
+        static void apply(uint64_t /* constant */, uint64_t /* N_value */, qpragma::quint_t<SIZE> & /* reg */);
+
+    private:
+        template <uint64_t SIZE>
+        static void _qft(qpragma::quint_t<SIZE + 1UL> & /* acc */);
+
+        template <uint64_t SIZE>
+        static void _inverse_qft(qpragma::quint_t<SIZE + 1UL> & /* acc */);
+
+        template <uint64_t SIZE>
+        static void _phase_add(uint64_t /* constant (two's complement) */, qpragma::quint_t<SIZE + 1UL> & /* acc */);
+
+        template <uint64_t SIZE>
+        static void _modular_add(
+            uint64_t /* constant */, uint64_t /* N_value */, qpragma::qbool & /* control */,
+            qpragma::quint_t<SIZE + 1UL> & /* acc */, qpragma::qbool & /* flag */
+        );
+
+        template <uint64_t SIZE>
+        static void _multiply_add(
+            const std::array<uint64_t, SIZE> & /* terms */, uint64_t /* N_value */, qpragma::quint_t<SIZE> & /* reg */,
+            qpragma::quint_t<SIZE + 1UL> & /* acc */, qpragma::qbool & /* flag */
+        );
+    };
+
+
+    /**
+     * Ripple-carry multiplier (3n + 4 qubits, control included)
+     * Modular adders are built using Cuccaro ripple-carry adders: constants are loaded in a
+     * register. This multiplier needs more qubits but fewer gates (O(n^2) instead of O(n^3))
+     */
+    struct ripple_carry_multiplier {
+        static constexpr multiplier_cost cost(uint64_t size) {
+            // Each adder uses 2n MAJ/UMA blocks (3 gates each) and a CNOT, each modular adder uses
+            // 5 adders and loads (or unloads) constants 8 times
+            const uint64_t adder_gates = 6UL * size + 1UL;
+            const uint64_t modular_adder_gates = 5UL * adder_gates + 8UL * size + 4UL;
+            const uint64_t modular_adder_depth = 5UL * adder_gates + 12UL;
+
+            return multiplier_cost {
+                .ancillas = 2UL * size + 3UL,
+                .gates = 2UL * size * modular_adder_gates + 3UL * size,
+                .depth = 2UL * size * modular_adder_depth + 3UL * size
+            };
+        }
+
+        /**
+         * Circuit multiplying by a given constant
+         * Classical constants are computed once, the circuit can be applied several times
+         */
+        template <uint64_t SIZE>
+        class circuit {
+        public:
+            circuit(uint64_t /* constant */, uint64_t /* N_value */);
+            void operator()(qpragma::quint_t<SIZE> & /* reg */) const;
+
+        private:
+            multiplication_terms<SIZE> _terms;
+        };
+
+        template <uint64_t SIZE>
+        static void apply(uint64_t /* constant */, uint64_t /* N_value */, qpragma::quint_t<SIZE> & /* reg */);
+
+    private:
+        static void _majority(qpragma::qbool & /* carry */, qpragma::qbool & /* target */, qpragma::qbool & /* value */);
+        static void _unmajority(qpragma::qbool & /* carry */, qpragma::qbool & /* target */, qpragma::qbool & /* value */);
+        static void _inverse_majority(qpragma::qbool & /* carry */, qpragma::qbool & /* target */, qpragma::qbool & /* value */);
+        static void _inverse_unmajority(qpragma::qbool & /* carry */, qpragma::qbool & /* target */, qpragma::qbool & /* value */);
+
+        template <uint64_t SIZE>
+        static void _load(uint64_t /* constant */, qpragma::quint_t<SIZE> & /* value */);
+
+        template <uint64_t SIZE>
+        static void _add(qpragma::quint_t<SIZE> & /* value */, qpragma::quint_t<SIZE + 1UL> & /* acc */, qpragma::qbool & /* carry */);
+
+        template <uint64_t SIZE>
+        static void _subtract(qpragma::quint_t<SIZE> & /* value */, qpragma::quint_t<SIZE + 1UL> & /* acc */, qpragma::qbool & /* carry */);
+
+        template <uint64_t SIZE>
+        static void _modular_add(
+            uint64_t /* constant */, uint64_t /* N_value */, qpragma::qbool & /* control */, qpragma::quint_t<SIZE> & /* value */,
+            qpragma::quint_t<SIZE + 1UL> & /* acc */, qpragma::qbool & /* carry */, qpragma::qbool & /* flag */
+        );
+
+        template <uint64_t SIZE>
+        static void _multiply_add(
+            const std::array<uint64_t, SIZE> & /* terms */, uint64_t /* N_value */, qpragma::quint_t<SIZE> & /* reg */, qpragma::quint_t<SIZE> & /* value */,
+            qpragma::quint_t<SIZE + 1UL> & /* acc */, qpragma::qbool & /* carry */, qpragma::qbool & /* flag */
+        );
+    };
+
+
+    /**
+     * Select the cheapest multiplier (only used if explicitly requested)
+     * The multiplier having the lowest emulation cost for a register of SIZE qubits is selected.
+     * The cost of "qpragma_multiplier" is a model, and the error of the approximate QFT of
+     * "draper_multiplier" is not taken into account: "qpragma_multiplier" is the default
+     */
+    template <uint64_t SIZE, typename FIRST, typename SECOND>
+    using cheaper_multiplier = std::conditional_t<
+        (emulation_cost(SECOND::cost(SIZE), SIZE) < emulation_cost(FIRST::cost(SIZE), SIZE)), SECOND, FIRST
+    >;
+
+    template <uint64_t SIZE>
+    using cheapest_multiplier = cheaper_multiplier<
+        SIZE, cheaper_multiplier<SIZE, qpragma_multiplier, draper_multiplier>, ripple_carry_multiplier
+    >;
+}
+
+#include "qpragma/shor/multiplier.ipp"
+
+#endif  /* QPRAGMA_SHOR_MULTIPLIER_H */
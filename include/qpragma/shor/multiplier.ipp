@@ -0,0 +1,383 @@
+/**
+ * Q-Pragma Shor's algorithm implementation
+ *
+ * This file provide the implementation of the controlled modular multipliers. These
+ * multipliers are not controlled: the control is added by the caller, using
+ * "#pragma quantum ctrl"
+ */
+
+/**
+ * Constants of the multiplication
+ */
+
+template <uint64_t SIZE>
+qpragma::shor::multiplication_terms<SIZE>::multiplication_terms(uint64_t constant, uint64_t N_value): N_value(N_value) {
+    uint64_t forward_term = constant % N_value;
+    uint64_t backward_term = N_value - qpragma::shor::mod_inverse(forward_term, N_value);
+
+    for (uint64_t idx = 0UL; idx < SIZE; ++idx) {
+        forward[idx] = forward_term;
+        backward[idx] = backward_term;
+
+        forward_term = (2UL * forward_term) % N_value;
+        backward_term = (2UL * backward_term) % N_value;
+    }
+}
+
+
+/**
+ * Q-Pragma multiplier
+ */
+
+template <uint64_t SIZE>
+void qpragma::shor::qpragma_multiplier::apply(uint64_t constant, uint64_t N_value, qpragma::quint_t<SIZE> & reg) {
+    qpragma::arith::mult_const_mod_in_place<SIZE>(constant, N_value)(reg);
+}
+
+
+/**
+ * Beauregard multiplier (Draper adders)
+ *
+ * In the Fourier space, the qubit "idx" of the accumulator stores the phase 2π acc / 2^(idx + 1)
+ */
+
+// Approximate QFT
+template <uint64_t SIZE>
+void qpragma::shor::draper_multiplier::_qft(qpragma::quint_t<SIZE + 1UL> & acc) {
+    for (uint64_t target = SIZE + 1UL; target-- > 0UL;) {
+        qpragma::H(acc[target]);
+
+        for (uint64_t distance = 1UL; distance <= target and distance < approximation(SIZE); ++distance) {
+            #pragma quantum ctrl(acc[target - distance])
+            (qpragma::PH(M_PI / static_cast<double>(1UL << distance)))(acc[target]);
+        }
+    }
+}
+
+
+// Inverse of the approximate QFT
+template <uint64_t SIZE>
+void qpragma::shor::draper_multiplier::_inverse_qft(qpragma::quint_t<SIZE + 1UL> & acc) {
+    for (uint64_t target = 0UL; target < SIZE + 1UL; ++target) {
+        for (uint64_t distance = std::min(target, approximation(SIZE) - 1UL); distance > 0UL; --distance) {
+            #pragma quantum ctrl(acc[target - distance])
+            (qpragma::PH(- M_PI / static_cast<double>(1UL << distance)))(acc[target]);
+        }
+
+        qpragma::H(acc[target]);
+    }
+}
+
+
+// Add a constant in the Fourier space (a negative constant is given using two's complement)
+template <uint64_t SIZE>
+void qpragma::shor::draper_multiplier::_phase_add(uint64_t constant, qpragma::quint_t<SIZE + 1UL> & acc) {
+    for (uint64_t idx = 0UL; idx < SIZE + 1UL; ++idx) {
+        uint64_t modulus = 1UL << (idx + 1UL);
+        double angle = 2. * M_PI * static_cast<double>(constant & (modulus - 1UL)) / static_cast<double>(modulus);
+
+        (qpragma::PH(angle))(acc[idx]);
+    }
+}
+
+
+// Add a constant modulo N if the control is set (acc < N is expected)
+template <uint64_t SIZE>
+void qpragma::shor::draper_multiplier::_modular_add(
+    uint64_t constant, uint64_t N_value, qpragma::qbool & control, qpragma::quint_t<SIZE + 1UL> & acc, qpragma::qbool & flag
+) {
+    // acc = acc + constant - N, the most significant bit is set if the result is negative
+    #pragma quantum ctrl(control)
+    _phase_add<SIZE>(constant, acc);
+    _phase_add<SIZE>(- N_value, acc);
+
+    _inverse_qft<SIZE>(acc);
+
+    #pragma quantum ctrl(acc[SIZE])
+    qpragma::X(flag);
+
+    _qft<SIZE>(acc);
+
+    // Add N back if the result is negative
+    #pragma quantum ctrl(flag)
+    _phase_add<SIZE>(N_value, acc);
+
+    // Uncompute flag: acc - constant is negative if and only if flag is not set
+    #pragma quantum ctrl(control)
+    _phase_add<SIZE>(- constant, acc);
+
+    _inverse_qft<SIZE>(acc);
+    qpragma::X(acc[SIZE]);
+
+    #pragma quantum ctrl(acc[SIZE])
+    qpragma::X(flag);
+
+    qpragma::X(acc[SIZE]);
+    _qft<SIZE>(acc);
+
+    #pragma quantum ctrl(control)
+    _phase_add<SIZE>(constant, acc);
+}
+
+
+// acc = acc + constant * reg modulo N
+template <uint64_t SIZE>
+void qpragma::shor::draper_multiplier::_multiply_add(
+    const std::array<uint64_t, SIZE> & terms, uint64_t N_value, qpragma::quint_t<SIZE> & reg,
+    qpragma::quint_t<SIZE + 1UL> & acc, qpragma::qbool & flag
+) {
+    _qft<SIZE>(acc);
+
+    for (uint64_t idx = 0UL; idx < SIZE; ++idx) {
+        _modular_add<SIZE>(terms[idx], N_value, reg[idx], acc, flag);
+    }
+
+    _inverse_qft<SIZE>(acc);
+}
+
+
+// Synthesize the multiplication by a constant modulo N
+template <uint64_t SIZE>
+qpragma::shor::draper_multiplier::circuit<SIZE>::circuit(uint64_t constant, uint64_t N_value): _terms(constant, N_value) {}
+
+
+// Multiply reg by the constant modulo N
+template <uint64_t SIZE>
+void qpragma::shor::draper_multiplier::circuit<SIZE>::operator()(qpragma::quint_t<SIZE> & reg) const {
+    qpragma::quint_t<SIZE + 1UL> acc = 0UL;
+    qpragma::qbool flag;
+
+    // acc = constant * reg
+    _multiply_add<SIZE>(_terms.forward, _terms.N_value, reg, acc, flag);
+
+    // Swap reg and acc
+    for (uint64_t idx = 0UL; idx < SIZE; ++idx) {
+        #pragma quantum ctrl(reg[idx])
+        qpragma::X(acc[idx]);
+
+        #pragma quantum ctrl(acc[idx])
+        qpragma::X(reg[idx]);
+
+        #pragma quantum ctrl(reg[idx])
+        qpragma::X(acc[idx]);
+    }
+
+    // acc = acc - constant^(-1) * reg = 0
+    _multiply_add<SIZE>(_terms.backward, _terms.N_value, reg, acc, flag);
+}
+
+
+// Multiply reg by a constant modulo N
+template <uint64_t SIZE>
+void qpragma::shor::draper_multiplier::apply(uint64_t constant, uint64_t N_value, qpragma::quint_t<SIZE> & reg) {
+    circuit<SIZE>(constant, N_value)(reg);
+}
+
+
+/**
+ * Ripple-carry multiplier (Cuccaro adders)
+ */
+
+// Majority block: carry of the next bit is stored in value
+inline void qpragma::shor::ripple_carry_multiplier::_majority(qpragma::qbool & carry, qpragma::qbool & target, qpragma::qbool & value) {
+    #pragma quantum ctrl(value)
+    qpragma::X(target);
+
+    #pragma quantum ctrl(value)
+    qpragma::X(carry);
+
+    #pragma quantum ctrl(carry, target)
+    qpragma::X(value);
+}
+
+
+// Unmajority block: restore value and carry and compute the sum in target
+inline void qpragma::shor::ripple_carry_multiplier::_unmajority(qpragma::qbool & carry, qpragma::qbool & target, qpragma::qbool & value) {
+    #pragma quantum ctrl(carry, target)
+    qpragma::X(value);
+
+    #pragma quantum ctrl(value)
+    qpragma::X(carry);
+
+    #pragma quantum ctrl(carry)
+    qpragma::X(target);
+}
+
+
+// Inverse of the majority block
+inline void qpragma::shor::ripple_carry_multiplier::_inverse_majority(qpragma::qbool & carry, qpragma::qbool & target, qpragma::qbool & value) {
+    #pragma quantum ctrl(carry, target)
+    qpragma::X(value);
+
+    #pragma quantum ctrl(value)
+    qpragma::X(carry);
+
+    #pragma quantum ctrl(value)
+    qpragma::X(target);
+}
+
+
+// Inverse of the unmajority block
+inline void qpragma::shor::ripple_carry_multiplier::_inverse_unmajority(qpragma::qbool & carry, qpragma::qbool & target, qpragma::qbool & value) {
+    #pragma quantum ctrl(carry)
+    qpragma::X(target);
+
+    #pragma quantum ctrl(value)
+    qpragma::X(carry);
+
+    #pragma quantum ctrl(carry, target)
+    qpragma::X(value);
+}
+
+
+// Load a constant (value is expected to be 0) or unload it
+template <uint64_t SIZE>
+void qpragma::shor::ripple_carry_multiplier::_load(uint64_t constant, qpragma::quint_t<SIZE> & value) {
+    for (uint64_t idx = 0UL; idx < SIZE; ++idx) {
+        if ((constant >> idx) & 1UL) {
+            qpragma::X(value[idx]);
+        }
+    }
+}
+
+
+// acc = acc + value modulo 2^(SIZE + 1)
+template <uint64_t SIZE>
+void qpragma::shor::ripple_carry_multiplier::_add(
+    qpragma::quint_t<SIZE> & value, qpragma::quint_t<SIZE + 1UL> & acc, qpragma::qbool & carry
+) {
+    _majority(carry, acc[0], value[0]);
+
+    for (uint64_t idx = 1UL; idx < SIZE; ++idx) {
+        _majority(value[idx - 1UL], acc[idx], value[idx]);
+    }
+
+    #pragma quantum ctrl(value[SIZE - 1UL])
+    qpragma::X(acc[SIZE]);
+
+    for (uint64_t idx = SIZE - 1UL; idx > 0UL; --idx) {
+        _unmajority(value[idx - 1UL], acc[idx], value[idx]);
+    }
+
+    _unmajority(carry, acc[0], value[0]);
+}
+
+
+// acc = acc - value modulo 2^(SIZE + 1) (inverse of the adder)
+template <uint64_t SIZE>
+void qpragma::shor::ripple_carry_multiplier::_subtract(
+    qpragma::quint_t<SIZE> & value, qpragma::quint_t<SIZE + 1UL> & acc, qpragma::qbool & carry
+) {
+    // Blocks are applied in the reverse order
+    _inverse_unmajority(carry, acc[0], value[0]);
+
+    for (uint64_t idx = 1UL; idx < SIZE; ++idx) {
+        _inverse_unmajority(value[idx - 1UL], acc[idx], value[idx]);
+    }
+
+    #pragma quantum ctrl(value[SIZE - 1UL])
+    qpragma::X(acc[SIZE]);
+
+    for (uint64_t idx = SIZE - 1UL; idx > 0UL; --idx) {
+        _inverse_majority(value[idx - 1UL], acc[idx], value[idx]);
+    }
+
+    _inverse_majority(carry, acc[0], value[0]);
+}
+
+
+// Add a constant modulo N if the control is set (acc < N is expected)
+template <uint64_t SIZE>
+void qpragma::shor::ripple_carry_multiplier::_modular_add(
+    uint64_t constant, uint64_t N_value, qpragma::qbool & control, qpragma::quint_t<SIZE> & value,
+    qpragma::quint_t<SIZE + 1UL> & acc, qpragma::qbool & carry, qpragma::qbool & flag
+) {
+    // acc = acc + constant - N, the most significant bit is set if the result is negative
+    #pragma quantum ctrl(control)
+    _load<SIZE>(constant, value);
+    _add<SIZE>(value, acc, carry);
+    #pragma quantum ctrl(control)
+    _load<SIZE>(constant, value);
+
+    _load<SIZE>(N_value, value);
+    _subtract<SIZE>(value, acc, carry);
+    _load<SIZE>(N_value, value);
+
+    #pragma quantum ctrl(acc[SIZE])
+    qpragma::X(flag);
+
+    // Add N back if the result is negative
+    #pragma quantum ctrl(flag)
+    _load<SIZE>(N_value, value);
+    _add<SIZE>(value, acc, carry);
+    #pragma quantum ctrl(flag)
+    _load<SIZE>(N_value, value);
+
+    // Uncompute flag: acc - constant is negative if and only if flag is not set
+    #pragma quantum ctrl(control)
+    _load<SIZE>(constant, value);
+    _subtract<SIZE>(value, acc, carry);
+
+    qpragma::X(acc[SIZE]);
+
+    #pragma quantum ctrl(acc[SIZE])
+    qpragma::X(flag);
+
+    qpragma::X(acc[SIZE]);
+
+    _add<SIZE>(value, acc, carry);
+    #pragma quantum ctrl(control)
+    _load<SIZE>(constant, value);
+}
+
+
+// acc = acc + constant * reg modulo N
+template <uint64_t SIZE>
+void qpragma::shor::ripple_carry_multiplier::_multiply_add(
+    const std::array<uint64_t, SIZE> & terms, uint64_t N_value, qpragma::quint_t<SIZE> & reg, qpragma::quint_t<SIZE> & value,
+    qpragma::quint_t<SIZE + 1UL> & acc, qpragma::qbool & carry, qpragma::qbool & flag
+) {
+    for (uint64_t idx = 0UL; idx < SIZE; ++idx) {
+        _modular_add<SIZE>(terms[idx], N_value, reg[idx], value, acc, carry, flag);
+    }
+}
+
+
+// Synthesize the multiplication by a constant modulo N
+template <uint64_t SIZE>
+qpragma::shor::ripple_carry_multiplier::circuit<SIZE>::circuit(uint64_t constant, uint64_t N_value): _terms(constant, N_value) {}
+
+
+// Multiply reg by the constant modulo N
+template <uint64_t SIZE>
+void qpragma::shor::ripple_carry_multiplier::circuit<SIZE>::operator()(qpragma::quint_t<SIZE> & reg) const {
+    qpragma::quint_t<SIZE> value = 0UL;
+    qpragma::quint_t<SIZE + 1UL> acc = 0UL;
+    qpragma::qbool carry;
+    qpragma::qbool flag;
+
+    // acc = constant * reg
+    _multiply_add<SIZE>(_terms.forward, _terms.N_value, reg, value, acc, carry, flag);
+
+    // Swap reg and acc
+    for (uint64_t idx = 0UL; idx < SIZE; ++idx) {
+        #pragma quantum ctrl(reg[idx])
+        qpragma::X(acc[idx]);
+
+        #pragma quantum ctrl(acc[idx])
+        qpragma::X(reg[idx]);
+
+        #pragma quantum ctrl(reg[idx])
+        qpragma::X(acc[idx]);
+    }
+
+    // acc = acc - constant^(-1) * reg = 0
+    _multiply_add<SIZE>(_terms.backward, _terms.N_value, reg, value, acc, carry, flag);
+}
+
+
+// Multiply reg by a constant modulo N
+template <uint64_t SIZE>
+void qpragma::shor::ripple_carry_multiplier::apply(uint64_t constant, uint64_t N_value, qpragma::quint_t<SIZE> & reg) {
+    circuit<SIZE>(constant, N_value)(reg);
+}
@@ -0,0 +1,175 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/post_processing.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Classical post-processing of Shor algorithm: extract divisors from an order
+ * and manage the number of attempts
+ */
+
+#ifndef QPRAGMA_SHOR_POST_PROCESSING_H
+#define QPRAGMA_SHOR_POST_PROCESSING_H
+
+#include <vector>
+#include <cstdint>
+
+#include "qpragma/shor/deadline.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Outcome of a single attempt of Shor algorithm
+     * Each failing attempt is classified by its failure mode
+     */
+    enum class attempt_outcome: uint8_t {
+        success = 0,        // At least one non-trivial divisor has been found
+        classical_gcd = 1,  // The base is not coprime with N, a divisor is found classically
+        no_candidate = 2,   // No convergent of the measurement leads to the order
+        odd_order = 3,      // The order is odd
+        trivial_split = 4   // The order is even but only trivial divisors are found
+    };
+
+
+    /**
+     * Result of the post-processing of one attempt
+     * If the attempt succeed, "factors" contains at least two factors and the product
+     * of these factors is equal to N
+     *
+     * An attempt is interrupted if the deadline expired before its order (or a divisor) was
+     * found: its outcome is not a failure mode of the attempt, and should not be recorded
+     */
+    struct attempt_result {
+        attempt_outcome outcome = attempt_outcome::no_candidate;
+        uint64_t order = 0UL;
+        std::vector<uint64_t> factors;
+        bool interrupted = false;
+    };
+
+
+    /**
+     * Refine a factorization
+     * Given a list of factors (whose product is N) and a divisor of N, split each
+     * factor sharing a non-trivial gcd with this divisor
+     */
+    void refine_factors(std::vector<uint64_t> & /* factors */, uint64_t /* divisor */);
+
+
+    /**
+     * Split N using an order
+     * Given a base x and a multiple r of the order of x modulo N, this function
+     * tries both gcd(x^(r/2) ± 1, N) (and all the intermediate square roots of 1
+     * when r is divisible by a power of two). The order is then reused to split
+     * the remaining cofactors, using the same base and a few small bases
+     *
+     * This function returns the factors found (their product is equal to N). If no
+     * divisor is found, { N } is returned. If the deadline expires, the factors found
+     * so far are returned
+     */
+    std::vector<uint64_t> split_with_order(
+        uint64_t /* base */, uint64_t /* order */, uint64_t /* N_value */, const deadline & /* limit */ = deadline()
+    );
+
+
+    /**
+     * Post-process an order
+     * Given the order of a base (or 0 if no order is found), classify the attempt and
+     * extract every divisor this order yields. The attempt is interrupted if the deadline has
+     * expired and neither an order nor a divisor has been found
+     */
+    attempt_result process_order(
+        uint64_t /* base */, uint64_t /* order */, uint64_t /* N_value */, const deadline & /* limit */ = deadline()
+    );
+
+
+    /**
+     * Largest number of bits of a measurement: a measurement (and the denominator 2^nb_bits of
+     * its phase) is stored in a uint64_t
+     */
+    constexpr uint64_t max_measured_bits = 63UL;
+
+
+    /**
+     * Post-process a measurement
+     * Given the measurement of a phase estimation using "nb_bits" bits, find the order
+     * of the base and extract every divisor this order yields. A measurement of more than
+     * "max_measured_bits" bits throws a std::out_of_range
+     */
+    attempt_result post_process(
+        uint64_t /* measurement */, uint64_t /* nb_bits */, uint64_t /* base */, uint64_t /* N_value */,
+        const deadline & /* limit */ = deadline()
+    );
+
+
+    /**
+     * Estimate the number of distinct prime factors of N
+     * Prime factors lower than "bound" are found by trial division, a remaining cofactor is
+     * counted as a single prime factor. The estimate is at least 2 (the worst case of the split
+     * probability), it is used as the prior of an attempt budget
+     */
+    uint64_t estimate_prime_factors(uint64_t /* N_value */, uint64_t /* bound */ = 1024UL);
+
+
+    /**
+     * Adaptive attempt budget
+     * Shor algorithm is probabilistic: an attempt succeeds if the order is found (probability
+     * "p_order") and if this order splits N (probability at least 1 - 1/2^(k - 1) where k is
+     * the number of distinct prime factors of N)
+     *
+     * These probabilities are initialized using a prior and are updated using the observed
+     * failure modes. The budget is the number of attempts needed to reach the requested
+     * probability of failure, bounded by a maximum number of attempts
+     */
+    class attempt_budget {
+    private:
+        double _failure_probability;
+        uint64_t _nb_prime_factors;
+        uint64_t _max_attempt;
+
+        uint64_t _nb_attempts = 0UL;
+        uint64_t _nb_measured = 0UL;
+        uint64_t _nb_orders = 0UL;
+        uint64_t _nb_splits = 0UL;
+
+    public:
+        explicit attempt_budget(
+            double /* failure_probability */ = 1e-3,
+            uint64_t /* nb_prime_factors */ = 2UL,
+            uint64_t /* max_attempt */ = 200UL
+        );
+
+        // Update budget
+        void record(attempt_outcome);
+
+        // Estimated probabilities
+        double order_probability() const;
+        double split_probability() const;
+        double success_probability() const;
+
+        // Budget
+        uint64_t attempts() const;
+        uint64_t total() const;
+        uint64_t maximum() const;
+        bool exhausted() const;
+    };
+}
+
+#endif  /* QPRAGMA_SHOR_POST_PROCESSING_H */
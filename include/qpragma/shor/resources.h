@@ -0,0 +1,90 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/resources.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Resource estimation of the quantum part of Shor algorithm
+ */
+
+#ifndef QPRAGMA_SHOR_RESOURCES_H
+#define QPRAGMA_SHOR_RESOURCES_H
+
+#include <cstdint>
+#include <ostream>
+
+
+namespace qpragma::shor {
+    /**
+     * Cost of a controlled modular multiplier acting on a register of "size" qubits
+     */
+    struct multiplier_cost {
+        uint64_t ancillas = 0UL;
+        uint64_t gates = 0UL;
+        uint64_t depth = 0UL;
+    };
+
+
+    /**
+     * Resources needed by "find_divisor"
+     * The quantum part is walked without simulation: gates are counted for one attempt,
+     * the emulator memory is the size of the state vector
+     */
+    struct resource_estimate {
+        uint64_t qubits = 0UL;
+        uint64_t controlled_multiplications = 0UL;
+        uint64_t synthesized_circuits = 0UL;
+        uint64_t hadamard_gates = 0UL;
+        uint64_t phase_gates = 0UL;
+        uint64_t measurements = 0UL;
+        uint64_t gates = 0UL;
+        uint64_t depth = 0UL;
+        uint64_t memory_bytes = 0UL;
+        double expected_attempts = 0.;
+        uint64_t max_attempts = 0UL;
+    };
+
+
+    /**
+     * Estimate resources of "find_divisor"
+     * This function walks the same loop as the quantum scope for a quantum register of
+     * "size" qubits and a number "N_value", using the multiplier cost "cost" (see
+     * "qpragma/shor/multiplier.h"). Circuits are planned and steps are skipped by the same
+     * functions as "measure_phase" (see "plan_circuits" and "uses_control"), measurements are
+     * unknown: the estimate is an upper bound
+     *
+     * If a base is given, multiplications elided for this base (see "qpragma/shor/squaring_chain.h")
+     * are not counted. Otherwise, the worst case (no elided multiplication) is estimated
+     *
+     * Throws std::out_of_range if N does not fit in the quantum register
+     */
+    resource_estimate estimate_resources(
+        uint64_t /* size */, uint64_t /* N_value */, const multiplier_cost & /* cost */, uint64_t /* base */ = 0UL
+    );
+}
+
+
+/**
+ * Display a resource estimate
+ */
+std::ostream & operator<<(std::ostream &, const qpragma::shor::resource_estimate &);
+
+#endif  /* QPRAGMA_SHOR_RESOURCES_H */
@@ -0,0 +1,141 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/squaring_chain.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Constants of the controlled multiplications of the phase estimation
+ */
+
+#ifndef QPRAGMA_SHOR_SQUARING_CHAIN_H
+#define QPRAGMA_SHOR_SQUARING_CHAIN_H
+
+#include <span>
+#include <cmath>
+#include <vector>
+#include <cstdint>
+
+#include "qpragma/shor/continued_fraction.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Step of the phase estimation
+     * The step "idx" applies a controlled multiplication by base^(2^(nb_steps - 1 - idx)) modulo N:
+     *  - identity: the constant is equal to 1, the multiplication can be skipped
+     *  - first_occurrence: index of the first step using the same constant (the circuit
+     *    synthesized for this step can be reused)
+     */
+    struct chain_step {
+        uint64_t constant = 1UL;
+        bool identity = true;
+        uint64_t first_occurrence = 0UL;
+    };
+
+
+    /**
+     * Computes the squaring chain of a base
+     * Returns the "nb_steps" steps of the phase estimation, in the order they are applied
+     * (this function can be used in constant expressions)
+     */
+    constexpr std::vector<chain_step> squaring_chain(uint64_t base, uint64_t nb_steps, uint64_t N_value) {
+        std::vector<chain_step> result(nb_steps);
+
+        // The last step uses base^1, each previous step uses the square of the next one
+        uint64_t constant = base % N_value;
+
+        for (uint64_t idx = nb_steps; idx-- > 0UL;) {
+            result[idx].constant = constant;
+            result[idx].identity = constant == 1UL;
+            constant = mul_mod(constant, constant, N_value);
+        }
+
+        // Find repeated constants (the chain is short, a linear search is used)
+        for (uint64_t idx = 0UL; idx < nb_steps; ++idx) {
+            result[idx].first_occurrence = idx;
+
+            for (uint64_t other = 0UL; other < idx; ++other) {
+                if (result[other].constant == result[idx].constant) {
+                    result[idx].first_occurrence = other;
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    /**
+     * Circuits applied by the phase estimation of a squaring chain
+     * A circuit is synthesized for the first occurrence of each constant (identities are not
+     * applied), repeated constants reuse this circuit:
+     *  - constants: constant of each synthesized circuit, in the order of synthesis
+     *  - indexes: index of the circuit applied by each step (0 for identities)
+     */
+    struct chain_circuits {
+        std::vector<uint64_t> constants;
+        std::vector<uint64_t> indexes;
+    };
+
+
+    constexpr chain_circuits plan_circuits(std::span<const chain_step> chain) {
+        chain_circuits result { {}, std::vector<uint64_t>(chain.size(), 0UL) };
+
+        for (uint64_t idx = 0UL; idx < chain.size(); ++idx) {
+            if (chain[idx].identity) {
+                continue;
+            }
+
+            if (chain[idx].first_occurrence == idx) {
+                result.indexes[idx] = result.constants.size();
+                result.constants.push_back(chain[idx].constant);
+            }
+
+            else {
+                result.indexes[idx] = result.indexes[chain[idx].first_occurrence];
+            }
+        }
+
+        return result;
+    }
+
+
+    /**
+     * Checks if a step of the phase estimation uses the control qubit, given the bits measured
+     * by the previous steps: leading identities always measure 0 (H PH(0) H = I)
+     */
+    constexpr bool uses_control(const chain_step & step, uint64_t measurement) {
+        return not (step.identity and measurement == 0UL);
+    }
+
+
+    /**
+     * Angle of the phase correction of the step "idx" of the semi-classical phase estimation
+     * The bits measured by the previous steps are the least significant bits of the phase
+     * measurement / 2^(idx + 1), they are removed before measuring the bit "idx"
+     */
+    constexpr double correction_angle(uint64_t measurement, uint64_t idx) {
+        return - 2. * M_PI * static_cast<double>(measurement) / static_cast<double>(2UL << idx);
+    }
+}
+
+#endif  /* QPRAGMA_SHOR_SQUARING_CHAIN_H */
@@ -0,0 +1,161 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/storage.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Storage of the amplitudes of the statevector emulator, in memory or in memory-mapped files
+ */
+
+#ifndef QPRAGMA_SHOR_STORAGE_H
+#define QPRAGMA_SHOR_STORAGE_H
+
+#include <memory>
+#include <string>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace qpragma::shor {
+    using amplitude = std::complex<double>;
+
+
+    /**
+     * Backend storing the amplitudes
+     *  - memory: amplitudes are stored in RAM
+     *  - mapped: amplitudes are stored in memory-mapped files (out-of-core emulation), the size
+     *    of the register is then bounded by the disk instead of the RAM
+     */
+    enum class storage_backend { memory, mapped };
+
+
+    /**
+     * Options of the storage
+     *  - backend: backend storing the amplitudes
+     *  - directory: directory of the mapped files (temporary directory if empty). Files are
+     *    unlinked as soon as they are mapped
+     *  - block_size: number of amplitudes of a block of a mapped file, blocks are streamed one
+     *    after the other and the next block is prefetched while the current one is processed
+     */
+    struct storage_options {
+        storage_backend backend = storage_backend::memory;
+        std::string directory = "";
+        uint64_t block_size = 1UL << 16UL;
+    };
+
+
+    /**
+     * Contiguous array of amplitudes, initialized to zero
+     * Amplitudes are processed by blocks: "prefetch" loads a range of amplitudes before it is
+     * used (this function is called from another thread and must not modify amplitudes)
+     */
+    class amplitude_storage {
+    protected:
+        uint64_t _size;
+        uint64_t _block_size;
+        amplitude * _data = nullptr;
+
+        amplitude_storage(uint64_t /* size */, uint64_t /* block_size */);
+
+    public:
+        // Destructor (non-copyable, see "clone")
+        virtual ~amplitude_storage() = default;
+        amplitude_storage(const amplitude_storage &) = delete;
+        amplitude_storage & operator=(const amplitude_storage &) = delete;
+
+        // Getters
+        uint64_t size() const;
+        uint64_t block_size() const;
+        amplitude * data();
+        const amplitude * data() const;
+
+        // Load a range of amplitudes (does nothing if the amplitudes are always resident)
+        virtual bool out_of_core() const;
+        virtual void prefetch(uint64_t /* first */, uint64_t /* count */) const;
+
+        // Hint that a range of amplitudes will be read soon, without loading it (the range is
+        // read ahead in the background if the amplitudes are not always resident)
+        virtual void advise(uint64_t /* first */, uint64_t /* count */) const;
+
+        // Create a storage using the same backend (amplitudes are copied if "copy" is true)
+        virtual std::unique_ptr<amplitude_storage> clone(bool /* copy */) const = 0;
+
+        // Create a storage using the same backend, whose amplitudes are overwritten by the caller
+        // (memory pages are not touched: they are placed by their first writer)
+        virtual std::unique_ptr<amplitude_storage> allocate() const = 0;
+    };
+
+
+    /**
+     * Amplitudes stored in RAM (a single block)
+     * Amplitudes are left uninitialized if "initialize" is false
+     */
+    class memory_storage: public amplitude_storage {
+    private:
+        struct deleter {
+            void operator()(amplitude *) const;
+        };
+
+        std::unique_ptr<amplitude, deleter> _amplitudes;
+
+    public:
+        explicit memory_storage(uint64_t /* size */, bool /* initialize */ = true);
+        std::unique_ptr<amplitude_storage> clone(bool /* copy */) const override;
+        std::unique_ptr<amplitude_storage> allocate() const override;
+    };
+
+
+    /**
+     * Amplitudes stored in an unlinked file, mapped in memory
+     * The file is sparse: blocks never written do not use the disk. Pages are loaded and evicted
+     * by the kernel, blocks are prefetched explicitly to overlap the disk and the computation
+     */
+    class mapped_storage: public amplitude_storage {
+    private:
+        std::string _directory;
+        std::size_t _mapped_size;
+
+    public:
+        mapped_storage(uint64_t /* size */, const std::string & /* directory */, uint64_t /* block_size */);
+        ~mapped_storage() override;
+
+        bool out_of_core() const override;
+        void prefetch(uint64_t /* first */, uint64_t /* count */) const override;
+        void advise(uint64_t /* first */, uint64_t /* count */) const override;
+        std::unique_ptr<amplitude_storage> clone(bool /* copy */) const override;
+        std::unique_ptr<amplitude_storage> allocate() const override;
+    };
+
+
+    // Create a storage of "size" amplitudes (initialized to zero if "initialize" is true)
+    std::unique_ptr<amplitude_storage> make_storage(
+        uint64_t /* size */, const storage_options & /* options */, bool /* initialize */ = true
+    );
+
+
+    // Read an amplitude without using it, to load its page (used by prefetch functions)
+    inline void touch(const amplitude & value) {
+        [[maybe_unused]] volatile double real = value.real();
+    }
+}
+
+#endif  /* QPRAGMA_SHOR_STORAGE_H */
@@ -0,0 +1,98 @@
+/* -*- coding: utf-8 -*- */
+/*
+ * @file        qpragma/shor/trace.h
+ * @authors     Arnaud GAZDA <arnaud.gazda@eviden.com>
+ *
+ * @copyright
+ *     Licensed to the Apache Software Foundation (ASF) under one
+ *     or more contributor license agreements.  See the NOTICE file
+ *     distributed with this work for additional information
+ *     regarding copyright ownership.  The ASF licenses this file
+ *     to you under the Apache License, Version 2.0 (the
+ *     "License"); you may not use this file except in compliance
+ *     with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing,
+ *     software distributed under the License is distributed on an
+ *     "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *     KIND, either express or implied.  See the License for the
+ *     specific language governing permissions and limitations
+ *     under the License.
+ *
+ * @brief
+ * Record and replay measurements of Shor algorithm
+ */
+
+#ifndef QPRAGMA_SHOR_TRACE_H
+#define QPRAGMA_SHOR_TRACE_H
+
+#include <string>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+
+#include "qpragma/shor/post_processing.h"
+
+
+namespace qpragma::shor {
+    /**
+     * Entry of a trace
+     * An entry describes one attempt: the number to divide, the size of the quantum register,
+     * the base, the measurement (using "nb_bits" bits) and the outcome of the post-processing
+     */
+    struct trace_entry {
+        uint64_t N_value = 0UL;
+        uint64_t size = 0UL;
+        uint64_t nb_bits = 0UL;
+        uint64_t base = 0UL;
+        uint64_t measurement = 0UL;
+        attempt_outcome outcome = attempt_outcome::no_candidate;
+
+        bool operator==(const trace_entry &) const = default;
+    };
+
+
+    /**
+     * Trace writer
+     * A trace is a binary file made of a header followed by entries. Integers of an entry
+     * are encoded using a variable length encoding (LEB128)
+     */
+    class trace_writer {
+    private:
+        std::ofstream _stream;
+
+    public:
+        explicit trace_writer(const std::string & /* path */);
+
+        void write(const trace_entry &);
+        void flush();
+    };
+
+
+    /**
+     * Trace reader
+     * Read entries of a trace written by a "trace_writer"
+     */
+    class trace_reader {
+    private:
+        std::ifstream _stream;
+
+    public:
+        explicit trace_reader(const std::string & /* path */);
+
+        // Read next entry (std::nullopt is returned at the end of the trace), truncated entries and
+        // entries which cannot be post-processed throw a std::runtime_error
+        std::optional<trace_entry> next();
+    };
+
+
+    /**
+     * Replay an entry
+     * Re-run only the classical post-processing of an attempt
+     */
+    attempt_result replay(const trace_entry &);
+}
+
+#endif  /* QPRAGMA_SHOR_TRACE_H */
@@ -0,0 +1,276 @@
+#include "qpragma/shor/autotuner.h"
+
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "qpragma/shor/campaign.h"
+#include "qpragma/shor/classical.h"
+#include "qpragma/shor/emulator.h"
+#include "qpragma/shor/post_processing.h"
+
+
+/**
+ * Internal functions
+ */
+
+// File format
+constexpr char model_header[] = "qpragma-shor-cost-model 1";
+
+// Largest number of shots per base considered by the tuner
+constexpr uint64_t max_tuned_shots = 64UL;
+
+// Shots sampled to calibrate the cost of an additional shot
+constexpr uint64_t calibration_shots = 8UL;
+
+// Semiprimes used to calibrate the classical order finder
+constexpr uint64_t classical_semiprimes[] = { 10007UL * 10009UL, 65519UL * 65521UL, 262139UL * 262147UL };
+
+
+// Duration of the fastest of "repetitions" executions of a function (in milliseconds)
+template <typename FUNCTION>
+double fastest_ms(uint64_t repetitions, FUNCTION && function) {
+    double result = std::numeric_limits<double>::infinity();
+
+    for (uint64_t idx = 0UL; idx < std::max(1UL, repetitions); ++idx) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        result = std::min(result, elapsed.count());
+    }
+
+    return result;
+}
+
+
+// Number of amplitude updates of the emulation of one shot
+inline double amplitude_steps(uint64_t size) {
+    return std::ldexp(2. * static_cast<double>(size), static_cast<int>(size));
+}
+
+
+// Storage of the amplitudes in memory, or in memory-mapped files of a directory
+qpragma::shor::storage_options make_storage_options(bool mapped, const std::string & directory) {
+    if (not mapped) {
+        return qpragma::shor::storage_options();
+    }
+
+    return qpragma::shor::storage_options {
+        .backend = qpragma::shor::storage_backend::mapped,
+        .directory = directory.empty() ? std::filesystem::temp_directory_path().string() : directory
+    };
+}
+
+
+/**
+ * Cost model persistence
+ */
+
+qpragma::shor::cost_model qpragma::shor::cost_model::load(const std::string & path) {
+    std::ifstream stream(path);
+    std::string line;
+
+    if (not std::getline(stream, line) or line != model_header) {
+        throw std::runtime_error("Invalid cost model \"" + path + "\"");
+    }
+
+    cost_model result;
+
+    while (std::getline(stream, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+
+        if (key == "classical_ns") {
+            fields >> result.classical_ns;
+        }
+
+        else if (key == "engine_ns") {
+            uint64_t nb_threads = 0UL;
+            fields >> nb_threads >> result.engine_ns[nb_threads];
+        }
+
+        else if (key == "shot_factor") {
+            fields >> result.shot_factor;
+        }
+
+        else if (key == "mapped_factor") {
+            fields >> result.mapped_factor;
+        }
+
+        else if (key == "memory_bytes") {
+            fields >> result.memory_bytes;
+        }
+
+        if (fields.fail()) {
+            throw std::runtime_error("Invalid cost model \"" + path + "\" - could not read \"" + line + "\"");
+        }
+    }
+
+    if (result.engine_ns.empty()) {
+        throw std::runtime_error("Invalid cost model \"" + path + "\" - no engine calibrated");
+    }
+
+    return result;
+}
+
+
+void qpragma::shor::cost_model::save(const std::string & path) const {
+    // The model is written in a temporary file of the same directory, then renamed: concurrent
+    // processes read either the previous model or the new one, never a partial model
+    std::string temporary_path = path + ".XXXXXX";
+    int file_descriptor = mkstemp(temporary_path.data());
+
+    if (file_descriptor < 0) {
+        throw std::runtime_error("Could not open cost model \"" + path + "\"");
+    }
+
+    fchmod(file_descriptor, 0644);
+    close(file_descriptor);
+
+    std::ofstream stream(temporary_path, std::ios::trunc);
+    stream << std::setprecision(std::numeric_limits<double>::max_digits10);
+    stream << model_header << '\n';
+    stream << "classical_ns " << classical_ns << '\n';
+
+    for (auto [nb_threads, duration_ns]: engine_ns) {
+        stream << "engine_ns " << nb_threads << ' ' << duration_ns << '\n';
+    }
+
+    stream << "shot_factor " << shot_factor << '\n';
+    stream << "mapped_factor " << mapped_factor << '\n';
+    stream << "memory_bytes " << memory_bytes << '\n';
+    stream.close();
+
+    if (not stream or std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+        std::filesystem::remove(temporary_path);
+        throw std::runtime_error("Could not write cost model \"" + path + "\"");
+    }
+}
+
+
+/**
+ * Calibration
+ */
+
+qpragma::shor::cost_model qpragma::shor::calibrate(const calibration_options & options) {
+    cost_model result;
+
+    // Classical order finder: baby-step giant-step uses O(sqrt(N)) steps
+    for (uint64_t N_value: classical_semiprimes) {
+        double duration_ms = fastest_ms(options.repetitions, [&]() { classical_order(2UL, N_value); });
+        result.classical_ns += duration_ms * 1e6 / std::sqrt(static_cast<double>(N_value)) / std::size(classical_semiprimes);
+    }
+
+    // Statevector emulator: one shot of the largest semiprime fitting in the register. Sessions
+    // are created before the measure, like the session shared by the attempts of a factorization
+    const uint64_t N_value = semiprimes(options.size).back();
+    const auto chain = squaring_chain(2UL, 2UL * options.size, N_value);
+
+    auto emulate_ms = [&](uint64_t nb_shots, const storage_options & storage, const engine_options & engine) {
+        auto session = std::make_shared<emulator_session>(storage, engine);
+
+        return fastest_ms(options.repetitions, [&]() {
+            random_stream stream(1UL, N_value, 2UL);
+            sample_phases(chain, N_value, options.size, nb_shots, stream, session);
+        });
+    };
+
+    const double reference_ms = emulate_ms(1UL, storage_options(), engine_options());
+    const uint64_t max_threads = options.max_threads != 0UL ? options.max_threads : std::max(1U, std::thread::hardware_concurrency());
+
+    result.engine_ns[1UL] = reference_ms * 1e6 / amplitude_steps(options.size);
+
+    for (uint64_t nb_threads = 2UL; nb_threads <= max_threads; nb_threads *= 2UL) {
+        engine_options engine { .engine = emulator_engine::parallel, .nb_threads = nb_threads };
+        result.engine_ns[nb_threads] = emulate_ms(1UL, storage_options(), engine) * 1e6 / amplitude_steps(options.size);
+    }
+
+    double shots_ms = emulate_ms(calibration_shots, storage_options(), engine_options());
+    result.shot_factor = std::max(0., (shots_ms / reference_ms - 1.) / static_cast<double>(calibration_shots - 1UL));
+
+    double mapped_ms = emulate_ms(1UL, make_storage_options(true, options.directory), engine_options());
+    result.mapped_factor = std::max(1., mapped_ms / reference_ms);
+
+    // Half of the physical memory is available for the amplitudes
+    result.memory_bytes = static_cast<uint64_t>(sysconf(_SC_PHYS_PAGES)) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) / 2UL;
+
+    return result;
+}
+
+
+qpragma::shor::cost_model qpragma::shor::load_or_calibrate(const std::string & path, const calibration_options & options) {
+    if (std::filesystem::exists(path)) {
+        return cost_model::load(path);
+    }
+
+    auto result = calibrate(options);
+    result.save(path);
+
+    return result;
+}
+
+
+/**
+ * Tuning
+ */
+
+qpragma::shor::tuning qpragma::shor::tune(
+    const cost_model & model, uint64_t size, uint64_t N_value, bool quantum_only, const std::string & directory
+) {
+    const attempt_budget prior;
+    tuning result { .expected_ms = std::numeric_limits<double>::infinity() };
+
+    // Classical order finder: the order is always found, the base splits N if this order is
+    // even (and gives non-trivial divisors)
+    if (not quantum_only) {
+        result.classical = true;
+        result.expected_ms = model.classical_ns * 1e-6 * std::sqrt(static_cast<double>(N_value)) / prior.split_probability();
+    }
+
+    // Statevector emulator: a shot finds the order with the prior probability of "attempt_budget",
+    // but the shots of a base share its split probability (the orders of a base are the same).
+    // Attempts measure 2 * size bits, which must fit in a measurement
+    if (2UL * size > max_measured_bits or size > max_register_size(storage_backend::mapped)) {
+        return result;
+    }
+
+    for (auto [nb_threads, duration_ns]: model.engine_ns) {
+        for (uint64_t nb_shots = 1UL; nb_shots <= max_tuned_shots; nb_shots *= 2UL) {
+            // Pending states of the shot tree, and the scratch storage of the current state
+            const double memory_bytes = static_cast<double>(nb_shots + 1UL) * std::ldexp(sizeof(amplitude), static_cast<int>(size));
+            const bool mapped = memory_bytes > static_cast<double>(model.memory_bytes)
+                             or size > max_register_size(storage_backend::memory);
+
+            double base_ms = duration_ns * 1e-6 * amplitude_steps(size) * (mapped ? model.mapped_factor : 1.)
+                           * (1. + static_cast<double>(nb_shots - 1UL) * model.shot_factor);
+            double success = prior.split_probability()
+                           * (1. - std::pow(1. - prior.order_probability(), static_cast<double>(nb_shots)));
+
+            if (base_ms / success < result.expected_ms) {
+                result.classical = false;
+                result.shots = nb_shots;
+                result.storage = make_storage_options(mapped, directory);
+                result.engine = nb_threads == 1UL
+                    ? engine_options()
+                    : engine_options { .engine = emulator_engine::parallel, .nb_threads = nb_threads };
+                result.expected_ms = base_ms / success;
+            }
+        }
+    }
+
+    return result;
+}
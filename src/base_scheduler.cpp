@@ -0,0 +1,155 @@
+#include "qpragma/shor/base_scheduler.h"
+
+#include <utility>
+
+
+/**
+ * Internal functions
+ */
+
+// Mix bits of a 64 bits integer (finalizer of splitmix64)
+inline uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30UL)) * 0xbf58476d1ce4e5b9UL;
+    value = (value ^ (value >> 27UL)) * 0x94d049bb133111ebUL;
+    return value ^ (value >> 31UL);
+}
+
+
+/**
+ * Random stream
+ */
+
+// Constructor
+qpragma::shor::random_stream::random_stream(uint64_t seed, uint64_t N_value, uint64_t attempt_idx):
+    _key(mix(mix(mix(seed) ^ N_value) ^ attempt_idx)) {}
+
+
+// Next value (splitmix64 evaluated at the position "counter" of the stream)
+uint64_t qpragma::shor::random_stream::operator()() {
+    return mix(_key + (++_counter) * 0x9e3779b97f4a7c15UL);
+}
+
+
+// Uniform value (values giving a biased modulo are rejected)
+uint64_t qpragma::shor::random_stream::uniform(uint64_t min_value, uint64_t max_value) {
+    const uint64_t range = max_value - min_value + 1UL;
+
+    if (range == 0UL) {
+        return (*this)();
+    }
+
+    const uint64_t threshold = (- range) % range;
+    uint64_t value = (*this)();
+
+    while (value < threshold) {
+        value = (*this)();
+    }
+
+    return min_value + value % range;
+}
+
+
+// Uniform floating point value (53 random bits)
+double qpragma::shor::random_stream::canonical() {
+    return static_cast<double>((*this)() >> 11UL) * 0x1.0p-53;
+}
+
+
+/**
+ * Jacobi symbol
+ */
+
+int qpragma::shor::jacobi_symbol(uint64_t value, uint64_t N_value) {
+    int result = 1;
+    value %= N_value;
+
+    while (value != 0UL) {
+        // (2 / n) = -1 if n = 3 or 5 modulo 8
+        while (value % 2UL == 0UL) {
+            value /= 2UL;
+
+            if (N_value % 8UL == 3UL or N_value % 8UL == 5UL) {
+                result = - result;
+            }
+        }
+
+        // Quadratic reciprocity
+        std::swap(value, N_value);
+
+        if (value % 4UL == 3UL and N_value % 4UL == 3UL) {
+            result = - result;
+        }
+
+        value %= N_value;
+    }
+
+    return N_value == 1UL ? result : 0;
+}
+
+
+/**
+ * Base scheduler
+ */
+
+// Constructor
+qpragma::shor::base_scheduler::base_scheduler(uint64_t N_value, uint64_t seed): _N_value(N_value), _seed(seed) {}
+
+
+// Checks if a base can be scheduled
+bool qpragma::shor::base_scheduler::is_eligible(uint64_t base) const {
+    return 2UL <= base and base + 2UL <= _N_value and not _scheduled.contains(base);
+}
+
+
+// Number of scheduled bases
+uint64_t qpragma::shor::base_scheduler::scheduled() const {
+    return _scheduled.size();
+}
+
+
+// Next base
+std::optional<uint64_t> qpragma::shor::base_scheduler::next() {
+    if (_N_value < 4UL) {
+        return std::nullopt;
+    }
+
+    // Draw candidates from the stream of the attempt, the first quadratic non-residue is
+    // selected (or the first eligible candidate)
+    random_stream stream(_seed, _N_value, _scheduled.size());
+    std::optional<uint64_t> result;
+
+    for (uint64_t idx = 0UL; idx < nb_candidates; ++idx) {
+        uint64_t candidate = stream.uniform(2UL, _N_value - 2UL);
+
+        if (not is_eligible(candidate)) {
+            continue;
+        }
+
+        if (jacobi_symbol(candidate, _N_value) == -1) {
+            result = candidate;
+            break;
+        }
+
+        if (not result) {
+            result = candidate;
+        }
+    }
+
+    // Most bases were already scheduled (small N): look for the next eligible base
+    if (not result) {
+        const uint64_t nb_bases = _N_value - 3UL;
+        const uint64_t start = stream.uniform(0UL, nb_bases - 1UL);
+
+        for (uint64_t offset = 0UL; offset < nb_bases and not result; ++offset) {
+            if (uint64_t candidate = 2UL + (start + offset) % nb_bases; is_eligible(candidate)) {
+                result = candidate;
+            }
+        }
+    }
+
+    if (result) {
+        _scheduled.insert(*result);
+    }
+
+    return result;
+}
@@ -0,0 +1,299 @@
+#include "qpragma/shor/cache.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/**
+ * Internal functions
+ */
+
+// File format
+constexpr uint64_t cache_magic = 0x3143524f48535051UL;  // "QPSHORC1"
+constexpr uint64_t cache_version = 1UL;
+constexpr std::size_t header_size = 2UL * sizeof(uint64_t);
+
+constexpr uint64_t factor_kind = 1UL;
+constexpr uint64_t order_kind = 2UL;
+
+
+// Mix bits of a 64 bits integer (finalizer of splitmix64)
+inline uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30UL)) * 0xbf58476d1ce4e5b9UL;
+    value = (value ^ (value >> 27UL)) * 0x94d049bb133111ebUL;
+    return value ^ (value >> 31UL);
+}
+
+
+// Computes the checksum of a record
+inline uint64_t compute_checksum(uint64_t kind, uint64_t N_value, uint64_t key, uint64_t value) {
+    uint64_t checksum = cache_magic;
+
+    for (uint64_t field: { kind, N_value, key, value }) {
+        checksum = mix(checksum ^ field);
+    }
+
+    return checksum;
+}
+
+
+// Get the size of a file
+inline std::size_t file_size(int file_descriptor) {
+    struct stat status;
+
+    if (fstat(file_descriptor, &status) != 0) {
+        throw std::runtime_error("Could not get the size of the cache");
+    }
+
+    return static_cast<std::size_t>(status.st_size);
+}
+
+
+// Size of the records of a file (a partially written record is rounded up to a whole record)
+inline std::size_t records_size(std::size_t size, std::size_t record_size) {
+    return size <= header_size ? 0UL : (size - header_size + record_size - 1UL) / record_size * record_size;
+}
+
+
+/**
+ * Lock of the cache file (exclusive for writers, shared for readers)
+ * The lock is released when this object is destroyed
+ */
+class file_lock {
+private:
+    int _file_descriptor;
+
+public:
+    file_lock(int file_descriptor, int operation = LOCK_EX): _file_descriptor(file_descriptor) {
+        if (flock(_file_descriptor, operation) != 0) {
+            throw std::runtime_error("Could not lock the cache");
+        }
+    }
+
+    file_lock(const file_lock &) = delete;
+    file_lock & operator=(const file_lock &) = delete;
+
+    ~file_lock() {
+        flock(_file_descriptor, LOCK_UN);
+    }
+};
+
+
+/**
+ * Order cache implementation
+ */
+
+// Constructor
+qpragma::shor::order_cache::order_cache(const std::string & path, bool read_only): _path(path), _read_only(read_only) {
+    _file_descriptor = open(_path.c_str(), _read_only ? O_RDONLY : (O_RDWR | O_CREAT), 0644);
+
+    if (_file_descriptor < 0) {
+        throw std::runtime_error("Could not open cache \"" + _path + "\"");
+    }
+
+    // Write header of a new cache (or of a cache whose header was partially written)
+    if (not _read_only) {
+        file_lock lock(_file_descriptor);
+
+        if (file_size(_file_descriptor) < header_size) {
+            const uint64_t header[2] = { cache_magic, cache_version };
+
+            if (
+                pwrite(_file_descriptor, header, header_size, 0) != static_cast<ssize_t>(header_size)
+                or fdatasync(_file_descriptor) != 0
+            ) {
+                close(_file_descriptor);
+                throw std::runtime_error("Could not initialize cache \"" + _path + "\"");
+            }
+        }
+    }
+
+    try {
+        refresh();
+    }
+
+    catch (...) {
+        close(_file_descriptor);
+        throw;
+    }
+}
+
+
+// Destructor
+qpragma::shor::order_cache::~order_cache() {
+    _unmap();
+    close(_file_descriptor);
+}
+
+
+// Unmap the file
+void qpragma::shor::order_cache::_unmap() {
+    if (_mapping != nullptr) {
+        munmap(const_cast<std::byte *>(_mapping), _mapped_size);
+    }
+
+    _mapping = nullptr;
+    _mapped_size = 0UL;
+}
+
+
+// Index a record
+void qpragma::shor::order_cache::_index(const record & item) {
+    if (item.kind == factor_kind) {
+        auto & factors = _factors[item.N_value];
+
+        if (std::ranges::find(factors, item.key) == factors.end()) {
+            factors.insert(std::ranges::upper_bound(factors, item.key), item.key);
+        }
+    }
+
+    else if (item.kind == order_kind) {
+        _orders[{ item.key, item.N_value }] = item.value;
+    }
+}
+
+
+// Append a record
+void qpragma::shor::order_cache::_append(record item) {
+    if (_read_only) {
+        throw std::runtime_error("Could not write in cache \"" + _path + "\" - cache opened in read-only mode");
+    }
+
+    item.checksum = compute_checksum(item.kind, item.N_value, item.key, item.value);
+
+    // Load records written by other processes, the record is written at the end of the file
+    // (after the record boundary following a partially written record)
+    file_lock lock(_file_descriptor);
+    _scan();
+
+    off_t offset = static_cast<off_t>(header_size + records_size(file_size(_file_descriptor), sizeof(record)));
+
+    if (
+        pwrite(_file_descriptor, &item, sizeof(record), offset) != static_cast<ssize_t>(sizeof(record))
+        or fdatasync(_file_descriptor) != 0
+    ) {
+        throw std::runtime_error("Could not write in cache \"" + _path + "\"");
+    }
+
+    _scan();
+}
+
+
+// Find factors
+std::vector<uint64_t> qpragma::shor::order_cache::find_factors(uint64_t N_value) {
+    if (not _factors.contains(N_value)) {
+        refresh();
+    }
+
+    auto iterator = _factors.find(N_value);
+    return iterator == _factors.end() ? std::vector<uint64_t>() : iterator->second;
+}
+
+
+// Find order
+std::optional<uint64_t> qpragma::shor::order_cache::find_order(uint64_t base, uint64_t N_value) {
+    if (not _orders.contains({ base, N_value })) {
+        refresh();
+    }
+
+    auto iterator = _orders.find({ base, N_value });
+
+    if (iterator == _orders.end()) {
+        return std::nullopt;
+    }
+
+    return iterator->second;
+}
+
+
+// Store factors
+void qpragma::shor::order_cache::store_factors(uint64_t N_value, const std::vector<uint64_t> & factors) {
+    for (uint64_t factor: factors) {
+        if (factor == 1UL or factor == N_value) {
+            continue;
+        }
+
+        if (auto known = find_factors(N_value); std::ranges::find(known, factor) == known.end()) {
+            _append(record { .kind = factor_kind, .N_value = N_value, .key = factor, .value = 0UL, .checksum = 0UL });
+        }
+    }
+}
+
+
+// Store order
+void qpragma::shor::order_cache::store_order(uint64_t base, uint64_t N_value, uint64_t order) {
+    if (not find_order(base, N_value)) {
+        _append(record { .kind = order_kind, .N_value = N_value, .key = base, .value = order, .checksum = 0UL });
+    }
+}
+
+
+// Refresh the mapping (writers hold an exclusive lock while appending a record)
+void qpragma::shor::order_cache::refresh() {
+    file_lock lock(_file_descriptor, LOCK_SH);
+    _scan();
+}
+
+
+// Map the file and index the new records
+void qpragma::shor::order_cache::_scan() {
+    std::size_t size = file_size(_file_descriptor);
+
+    if (size == _mapped_size) {
+        return;
+    }
+
+    // Map the whole file
+    _unmap();
+
+    if (size < header_size) {
+        return;
+    }
+
+    void * mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, _file_descriptor, 0);
+
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Could not map cache \"" + _path + "\"");
+    }
+
+    _mapping = static_cast<const std::byte *>(mapping);
+    _mapped_size = size;
+
+    // Check header
+    uint64_t header[2];
+    std::memcpy(header, _mapping, header_size);
+
+    if (header[0] != cache_magic or header[1] != cache_version) {
+        _unmap();
+        throw std::runtime_error("Invalid cache \"" + _path + "\"");
+    }
+
+    // Index new records, invalid records (partially written) are skipped. A record being
+    // written is never read: the lock is held
+    std::size_t nb_records = (size - header_size) / sizeof(record);
+
+    for (; _nb_scanned < nb_records; ++_nb_scanned) {
+        record item;
+        std::memcpy(&item, _mapping + header_size + _nb_scanned * sizeof(record), sizeof(record));
+
+        if (item.checksum != compute_checksum(item.kind, item.N_value, item.key, item.value)) {
+            continue;
+        }
+
+        _index(item);
+        ++_nb_indexed;
+    }
+}
+
+
+// Number of records
+std::size_t qpragma::shor::order_cache::size() const {
+    return _nb_indexed;
+}
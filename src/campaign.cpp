@@ -0,0 +1,126 @@
+#include "qpragma/shor/campaign.h"
+
+#include "qpragma/shor/base_scheduler.h"
+
+
+/**
+ * Internal functions
+ */
+
+// Checks if a number is prime (trial division)
+inline bool is_prime(uint64_t value) {
+    if (value < 2UL) {
+        return false;
+    }
+
+    for (uint64_t divisor = 2UL; divisor * divisor <= value; ++divisor) {
+        if (value % divisor == 0UL) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * Corpus
+ */
+
+// Generate semiprimes
+std::vector<uint64_t> qpragma::shor::semiprimes(uint64_t size) {
+    const uint64_t limit = 1UL << size;
+    std::vector<uint64_t> result;
+
+    for (uint64_t N_value = 15UL; N_value < limit; N_value += 2UL) {
+        for (uint64_t p_value = 3UL; p_value * p_value < N_value; p_value += 2UL) {
+            if (N_value % p_value == 0UL) {
+                if (is_prime(p_value) and is_prime(N_value / p_value)) {
+                    result.push_back(N_value);
+                }
+
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+// Base of an attempt
+uint64_t qpragma::shor::campaign_base(uint64_t seed, uint64_t N_value, uint64_t attempt_idx) {
+    return random_stream(seed, N_value, attempt_idx).uniform(2UL, N_value - 1UL);
+}
+
+
+/**
+ * Statistics
+ */
+
+// Record an attempt
+void qpragma::shor::campaign_statistics::record(attempt_outcome outcome, double time_ms) {
+    ++attempts;
+    ++outcomes[static_cast<uint8_t>(outcome)];
+    total_time_ms += time_ms;
+}
+
+
+// Merge statistics
+qpragma::shor::campaign_statistics & qpragma::shor::campaign_statistics::operator+=(const campaign_statistics & other) {
+    attempts += other.attempts;
+    total_time_ms += other.total_time_ms;
+
+    for (uint64_t idx = 0UL; idx < outcomes.size(); ++idx) {
+        outcomes[idx] += other.outcomes[idx];
+    }
+
+    return *this;
+}
+
+
+// Count attempts having a given outcome
+uint64_t qpragma::shor::campaign_statistics::count(attempt_outcome outcome) const {
+    return outcomes[static_cast<uint8_t>(outcome)];
+}
+
+
+// Success probability of an attempt using the quantum part
+double qpragma::shor::campaign_statistics::success_probability() const {
+    uint64_t quantum_attempts = attempts - count(attempt_outcome::classical_gcd);
+
+    if (quantum_attempts == 0UL) {
+        return 0.;
+    }
+
+    return static_cast<double>(count(attempt_outcome::success)) / static_cast<double>(quantum_attempts);
+}
+
+
+// Mean time of an attempt
+double qpragma::shor::campaign_statistics::time_per_attempt_ms() const {
+    return attempts == 0UL ? 0. : total_time_ms / static_cast<double>(attempts);
+}
+
+
+/**
+ * CSV
+ */
+
+void qpragma::shor::write_csv_header(std::ostream & stream) {
+    stream << "N,size,attempts,success,classical_gcd,no_candidate,odd_order,trivial_split,success_probability,time_per_attempt_ms\n";
+}
+
+
+void qpragma::shor::write_csv(std::ostream & stream, const campaign_statistics & statistics) {
+    stream << statistics.N_value << ','
+           << statistics.size << ','
+           << statistics.attempts << ','
+           << statistics.count(attempt_outcome::success) << ','
+           << statistics.count(attempt_outcome::classical_gcd) << ','
+           << statistics.count(attempt_outcome::no_candidate) << ','
+           << statistics.count(attempt_outcome::odd_order) << ','
+           << statistics.count(attempt_outcome::trivial_split) << ','
+           << statistics.success_probability() << ','
+           << statistics.time_per_attempt_ms() << '\n';
+}
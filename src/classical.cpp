@@ -0,0 +1,279 @@
+#include "qpragma/shor/classical.h"
+
+#include <bit>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+#include <unordered_map>
+
+#include "qpragma/shor/continued_fraction.h"
+
+
+/**
+ * Internal functions
+ */
+
+// Number of iterations between two checks of the deadline
+constexpr uint64_t deadline_period = 1024UL;
+
+// Maximal number of baby steps (the table uses O(sqrt(order)) memory)
+constexpr uint64_t max_baby_steps = 1UL << 20UL;
+
+// Number of kangaroo walks (using different jumps) before giving up
+constexpr uint64_t max_kangaroo_walks = 16UL;
+
+
+// Mix bits of a 64 bits integer (finalizer of splitmix64)
+inline uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30UL)) * 0xbf58476d1ce4e5b9UL;
+    value = (value ^ (value >> 27UL)) * 0x94d049bb133111ebUL;
+    return value ^ (value >> 31UL);
+}
+
+
+// Modular exponentiation from the most significant bit of the exponent, computed without
+// "mul_mod" and "pow_mod" (it validates the orders found using these functions)
+inline uint64_t independent_pow_mod(uint64_t base, uint64_t exponent, uint64_t modulus) {
+    using wide = unsigned __int128;
+    const wide power = base % modulus;
+    wide result = 1UL % modulus;
+
+    for (int bit = std::bit_width(exponent); bit-- > 0;) {
+        result = result * result % modulus;
+
+        if ((exponent >> bit) & 1UL) {
+            result = result * power % modulus;
+        }
+    }
+
+    return static_cast<uint64_t>(result);
+}
+
+
+// Integer square root (rounded down)
+inline uint64_t integer_sqrt(uint64_t value) {
+    uint64_t result = static_cast<uint64_t>(std::sqrt(static_cast<double>(value)));
+
+    while (result > 0UL and result > value / result) {
+        --result;
+    }
+
+    while ((result + 1UL) <= value / (result + 1UL)) {
+        ++result;
+    }
+
+    return result;
+}
+
+
+// Reduce a multiple of the order of x to the order, using the prime factors of this multiple
+uint64_t reduce_order(uint64_t x_value, uint64_t multiple, uint64_t N_value, const qpragma::shor::deadline & limit) {
+    uint64_t order = multiple;
+    uint64_t rest = multiple;
+
+    for (uint64_t prime = 2UL, idx = 0UL; prime <= rest / prime; prime += prime == 2UL ? 1UL : 2UL, ++idx) {
+        if (idx % deadline_period == 0UL and limit.expired()) {
+            return 0UL;
+        }
+
+        if (rest % prime != 0UL) {
+            continue;
+        }
+
+        while (rest % prime == 0UL) {
+            rest /= prime;
+        }
+
+        while (order % prime == 0UL and qpragma::shor::pow_mod(x_value, order / prime, N_value) == 1UL) {
+            order /= prime;
+        }
+    }
+
+    // The remaining factor is prime
+    if (rest > 1UL and qpragma::shor::pow_mod(x_value, order / rest, N_value) == 1UL) {
+        order /= rest;
+    }
+
+    return order;
+}
+
+
+// Pollard's kangaroo: find a multiple of the order of x, knowing that the order is in [lower, upper]
+// The tame kangaroo starts at x^upper and sets a trap at the end of its walk. The wild kangaroo
+// starts at 1 = x^order: if it falls in the trap, "upper + tame distance - wild distance" is a
+// multiple of the order. Returns 0 if the wild kangaroo misses the trap
+uint64_t kangaroo(
+    uint64_t x_value, uint64_t N_value, uint64_t lower, uint64_t upper, uint64_t salt, const qpragma::shor::deadline & limit
+) {
+    const uint64_t width = upper - lower;
+    const uint64_t nb_tame_jumps = 2UL * integer_sqrt(width) + 1UL;
+
+    // Jumps are powers of two, their mean is about sqrt(width) / 2
+    std::vector<uint64_t> jumps;
+    std::vector<uint64_t> powers;
+
+    for (uint64_t jump = 1UL; jumps.empty() or (2UL * jump - 1UL) / (jumps.size() + 1UL) <= integer_sqrt(width) / 2UL; jump *= 2UL) {
+        jumps.push_back(jump);
+        powers.push_back(qpragma::shor::pow_mod(x_value, jump, N_value));
+    }
+
+    auto next_jump = [&](uint64_t position) {
+        return mix(position ^ salt) % jumps.size();
+    };
+
+    // Tame kangaroo
+    uint64_t tame = qpragma::shor::pow_mod(x_value, upper, N_value);
+    uint64_t tame_distance = 0UL;
+
+    for (uint64_t idx = 0UL; idx < nb_tame_jumps; ++idx) {
+        if (idx % deadline_period == 0UL and limit.expired()) {
+            return 0UL;
+        }
+
+        uint64_t jump = next_jump(tame);
+        tame = qpragma::shor::mul_mod(tame, powers[jump], N_value);
+        tame_distance += jumps[jump];
+    }
+
+    // Wild kangaroo
+    uint64_t wild = 1UL;
+    uint64_t wild_distance = 0UL;
+
+    for (uint64_t idx = 0UL; wild_distance <= width + tame_distance; ++idx) {
+        if (idx % deadline_period == 0UL and limit.expired()) {
+            return 0UL;
+        }
+
+        if (wild == tame) {
+            return upper + tame_distance - wild_distance;
+        }
+
+        uint64_t jump = next_jump(wild);
+        wild = qpragma::shor::mul_mod(wild, powers[jump], N_value);
+        wild_distance += jumps[jump];
+    }
+
+    return 0UL;
+}
+
+
+/**
+ * Trial division
+ */
+
+uint64_t qpragma::shor::trial_division(uint64_t N_value, const deadline & limit) {
+    if (N_value % 2UL == 0UL) {
+        return N_value > 2UL ? 2UL : 0UL;
+    }
+
+    for (uint64_t divisor = 3UL, idx = 0UL; divisor <= N_value / divisor; divisor += 2UL, ++idx) {
+        if (idx % deadline_period == 0UL and limit.expired()) {
+            return 0UL;
+        }
+
+        if (N_value % divisor == 0UL) {
+            return divisor;
+        }
+    }
+
+    return 0UL;
+}
+
+
+/**
+ * Classical order finding
+ */
+
+uint64_t qpragma::shor::classical_order(uint64_t x_value, uint64_t N_value, const deadline & limit) {
+    if (N_value < 2UL or std::gcd(x_value, N_value) != 1UL) {
+        return 0UL;
+    }
+
+    // The order is lower than N: baby steps x^j (j < m) and giant steps x^(i m) (i <= m) find
+    // orders lower than m^2
+    const uint64_t nb_steps = std::min(integer_sqrt(N_value) + 1UL, max_baby_steps);
+    std::unordered_map<uint64_t, uint64_t> baby_steps;
+    uint64_t power = 1UL;
+
+    baby_steps.reserve(nb_steps);
+
+    for (uint64_t idx = 0UL; idx < nb_steps; ++idx) {
+        baby_steps.emplace(power, idx);
+        power = mul_mod(power, x_value, N_value);
+
+        if (power == 1UL) {
+            return idx + 1UL;
+        }
+    }
+
+    // Giant steps: the first x^(i m) = x^j gives the order i m - j
+    const uint64_t giant_step = power;
+    uint64_t giant = 1UL;
+
+    for (uint64_t idx = 1UL; idx <= nb_steps; ++idx) {
+        if (idx % deadline_period == 0UL and limit.expired()) {
+            return 0UL;
+        }
+
+        giant = mul_mod(giant, giant_step, N_value);
+
+        if (auto baby = baby_steps.find(giant); baby != baby_steps.end()) {
+            return idx * nb_steps - baby->second;
+        }
+    }
+
+    // Large orders (in [m^2, N]): kangaroo walks using different jumps
+    baby_steps.clear();
+
+    for (uint64_t walk = 0UL; nb_steps * nb_steps < N_value and walk < max_kangaroo_walks and not limit.expired(); ++walk) {
+        if (uint64_t multiple = kangaroo(x_value, N_value, nb_steps * nb_steps, N_value, mix(walk), limit); multiple != 0UL) {
+            return reduce_order(x_value, multiple, N_value, limit);
+        }
+    }
+
+    return 0UL;
+}
+
+
+/**
+ * Validation of the post-processing
+ */
+
+void qpragma::shor::validate_order(uint64_t x_value, uint64_t order, uint64_t N_value, const deadline & limit) {
+    const std::string description = "Invalid order " + std::to_string(order) + " of " + std::to_string(x_value)
+                                  + " modulo " + std::to_string(N_value);
+
+    if (order == 0UL or independent_pow_mod(x_value, order, N_value) != 1UL) {
+        throw std::logic_error(description + " - x^order is not 1");
+    }
+
+    // The order is minimal if x^(order / q) is not 1 for each prime factor q of the order
+    auto check_factor = [&](uint64_t factor) {
+        if (independent_pow_mod(x_value, order / factor, N_value) == 1UL) {
+            throw std::logic_error(description + " - x^" + std::to_string(order / factor) + " is already 1");
+        }
+    };
+
+    uint64_t remaining = order;
+
+    for (uint64_t factor = 2UL, idx = 0UL; factor <= remaining / factor; factor += factor == 2UL ? 1UL : 2UL, ++idx) {
+        if (idx % deadline_period == 0UL and limit.expired()) {
+            return;
+        }
+
+        if (remaining % factor == 0UL) {
+            check_factor(factor);
+
+            while (remaining % factor == 0UL) {
+                remaining /= factor;
+            }
+        }
+    }
+
+    if (remaining > 1UL) {
+        check_factor(remaining);
+    }
+}
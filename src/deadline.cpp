@@ -0,0 +1,28 @@
+#include "qpragma/shor/deadline.h"
+
+
+// Constructor
+qpragma::shor::deadline::deadline(std::chrono::milliseconds time_budget): _end(clock::now() + time_budget) {}
+
+
+// Checks if the deadline is infinite
+bool qpragma::shor::deadline::is_infinite() const {
+    return not _end.has_value();
+}
+
+
+// Checks if the deadline has expired
+bool qpragma::shor::deadline::expired() const {
+    return _end and clock::now() >= *_end;
+}
+
+
+// Remaining time
+std::chrono::milliseconds qpragma::shor::deadline::remaining() const {
+    if (not _end) {
+        return std::chrono::milliseconds::max();
+    }
+
+    auto now = clock::now();
+    return now >= *_end ? std::chrono::milliseconds(0) : std::chrono::duration_cast<std::chrono::milliseconds>(*_end - now);
+}
@@ -7,7 +7,7 @@
 
 
 // Display a continued fraction
-void qpragma::shor::pretty_display(const std::list<int64_t> & numbers) {
+void qpragma::shor::pretty_display(const std::vector<int64_t> & numbers) {
     // Ensure result not empty
     if (numbers.empty()) {
         return;
@@ -50,6 +50,16 @@ void qpragma::shor::pretty_display(const std::list<int64_t> & numbers) {
 qpragma::shor::progress_display::progress_display(uint64_t progress_size) : boost::timer::progress_display(progress_size) {}
 
 
+// Advance the progress bar
+void qpragma::shor::progress_display::advance_to(uint64_t target_count) {
+    target_count = std::min<uint64_t>(target_count, expected_count());
+
+    if (target_count > count()) {
+        (*this) += target_count - count();
+    }
+}
+
+
 // Destructor
 qpragma::shor::progress_display::~progress_display() {
     if (count() == expected_count()) {
@@ -66,15 +76,15 @@ qpragma::shor::progress_display::~progress_display() {
  * Additional operators
  */
 
-// Display a list
-std::ostream & operator<<(std::ostream & stream, const std::list<int64_t> & list) {
+// Display a vector
+std::ostream & operator<<(std::ostream & stream, const std::vector<int64_t> & numbers) {
     stream << "[";
-    auto iterator = list.begin();
+    auto iterator = numbers.begin();
 
-    while (iterator != list.end()) {
+    while (iterator != numbers.end()) {
         stream << (*iterator);
 
-        if (++iterator != list.end()) {
+        if (++iterator != numbers.end()) {
             stream << ", ";
         }
     }
@@ -0,0 +1,330 @@
+#include "qpragma/shor/emulator.h"
+
+#include <cmath>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include "qpragma/shor/continued_fraction.h"
+#include "qpragma/shor/post_processing.h"
+
+
+/**
+ * Session implementation
+ */
+
+// Constructors
+qpragma::shor::emulator_session::emulator_session(
+    const storage_options & storage, const engine_options & engine, uint64_t max_released
+):
+    emulator_session(storage, make_engine(engine), max_released)
+{}
+
+
+qpragma::shor::emulator_session::emulator_session(
+    const storage_options & storage, std::shared_ptr<statevector_engine> engine, uint64_t max_released
+):
+    _storage(storage), _engine(std::move(engine)), _max_released(max_released), _nb_allocations(0UL)
+{}
+
+
+// Getters
+const qpragma::shor::storage_options & qpragma::shor::emulator_session::storage() const {
+    return _storage;
+}
+
+
+qpragma::shor::statevector_engine & qpragma::shor::emulator_session::engine() const {
+    return *_engine;
+}
+
+
+uint64_t qpragma::shor::emulator_session::nb_allocations() const {
+    return _nb_allocations;
+}
+
+
+uint64_t qpragma::shor::emulator_session::nb_released() const {
+    return _released.size();
+}
+
+
+// Storages
+std::unique_ptr<qpragma::shor::amplitude_storage> qpragma::shor::emulator_session::zeros(uint64_t size) {
+    auto result = _recycle(size);
+
+    // Amplitudes in memory are first written by the engine (see "parallel_engine"), holes of
+    // a new mapped file are already read as zeros
+    if (not result) {
+        result = make_storage(size, _storage, false);
+        ++_nb_allocations;
+
+        if (result->out_of_core()) {
+            return result;
+        }
+    }
+
+    _engine->fill_zeros(*result);
+    return result;
+}
+
+
+std::unique_ptr<qpragma::shor::amplitude_storage> qpragma::shor::emulator_session::copy(const amplitude_storage & input) {
+    auto result = scratch(input.size());
+    _engine->copy(input, *result);
+
+    return result;
+}
+
+
+std::unique_ptr<qpragma::shor::amplitude_storage> qpragma::shor::emulator_session::scratch(uint64_t size) {
+    if (auto result = _recycle(size)) {
+        return result;
+    }
+
+    ++_nb_allocations;
+    return make_storage(size, _storage, false);
+}
+
+
+// Storages beyond "max_released" are freed
+void qpragma::shor::emulator_session::release(std::unique_ptr<amplitude_storage> storage) {
+    if (storage and _released.size() < _max_released) {
+        _released.push_back(std::move(storage));
+    }
+}
+
+
+std::unique_ptr<qpragma::shor::amplitude_storage> qpragma::shor::emulator_session::_recycle(uint64_t size) {
+    auto found = std::find_if(_released.rbegin(), _released.rend(), [size](const auto & storage) {
+        return storage->size() == size;
+    });
+
+    if (found == _released.rend()) {
+        return nullptr;
+    }
+
+    auto result = std::move(*found);
+    _released.erase(std::next(found).base());
+
+    return result;
+}
+
+
+/**
+ * Statevector implementation
+ */
+
+// Constructors
+qpragma::shor::statevector::statevector(uint64_t size, std::shared_ptr<emulator_session> session):
+    _size(size), _session(std::move(session))
+{
+    if (size == 0UL or size > max_register_size(_session->storage().backend)) {
+        throw std::out_of_range("Could not create a statevector - unsupported register size");
+    }
+
+    _storage = _session->zeros(1UL << size);
+    _storage->data()[1UL] = amplitude(1., 0.);
+}
+
+
+qpragma::shor::statevector::statevector(
+    uint64_t size, std::shared_ptr<emulator_session> session, std::unique_ptr<amplitude_storage> storage
+):
+    _size(size), _session(std::move(session)), _storage(std::move(storage))
+{}
+
+
+qpragma::shor::statevector::statevector(const statevector & other):
+    _size(other._size), _session(other._session), _storage(other._session->copy(*other._storage))
+{}
+
+
+qpragma::shor::statevector::statevector(statevector && other) noexcept:
+    _size(other._size), _session(std::move(other._session)), _storage(std::move(other._storage)),
+    _scratch(std::move(other._scratch))
+{}
+
+
+qpragma::shor::statevector & qpragma::shor::statevector::operator=(const statevector & other) {
+    if (this != &other) {
+        *this = statevector(other);
+    }
+
+    return *this;
+}
+
+
+// Storages of this state are released by "other"
+qpragma::shor::statevector & qpragma::shor::statevector::operator=(statevector && other) noexcept {
+    std::swap(_size, other._size);
+    std::swap(_session, other._session);
+    std::swap(_storage, other._storage);
+    std::swap(_scratch, other._scratch);
+
+    return *this;
+}
+
+
+qpragma::shor::statevector::~statevector() {
+    if (_session) {
+        _session->release(std::move(_storage));
+        _session->release(std::move(_scratch));
+    }
+}
+
+
+// Getters
+uint64_t qpragma::shor::statevector::size() const {
+    return _size;
+}
+
+
+std::span<const qpragma::shor::amplitude> qpragma::shor::statevector::amplitudes() const {
+    return std::span<const amplitude>(_storage->data(), _storage->size());
+}
+
+
+// Probability of measuring 0: squared norm of (psi + e^(i angle) U psi) / 2
+double qpragma::shor::statevector::probability(const chain_step & step, uint64_t N_value, double angle) const {
+    // U is the identity: |1 + e^(i angle)|^2 / 4
+    if (step.identity) {
+        return (1. + std::cos(angle)) / 2.;
+    }
+
+    // (U psi)[y] = psi[a^(-1) y mod N] for y < N
+    return _session->engine().norm(*_storage, mod_inverse(step.constant, N_value), N_value, std::polar(1., angle)) / 4.;
+}
+
+
+// Project the register on an outcome
+void qpragma::shor::statevector::project(
+    const chain_step & step, uint64_t N_value, double angle, bool outcome, double probability
+) {
+    // U is the identity: the register is unchanged (up to a global phase)
+    if (step.identity) {
+        return;
+    }
+
+    if (not _scratch) {
+        _scratch = _session->scratch(_storage->size());
+    }
+
+    _combine(step, N_value, angle, outcome, probability, *_scratch);
+    std::swap(_storage, _scratch);
+}
+
+
+// Project a new state on an outcome: the projection is directly written in its storage
+qpragma::shor::statevector qpragma::shor::statevector::projection(
+    const chain_step & step, uint64_t N_value, double angle, bool outcome, double probability
+) const {
+    if (step.identity) {
+        return *this;
+    }
+
+    statevector result(_size, _session, _session->scratch(_storage->size()));
+    _combine(step, N_value, angle, outcome, probability, *result._storage);
+
+    return result;
+}
+
+
+void qpragma::shor::statevector::_combine(
+    const chain_step & step, uint64_t N_value, double angle, bool outcome, double probability, amplitude_storage & output
+) const {
+    const amplitude phase = std::polar(outcome ? -1. : 1., angle);
+    const double scale = 1. / (2. * std::sqrt(probability));
+
+    _session->engine().combine(*_storage, output, mod_inverse(step.constant, N_value), N_value, phase, scale);
+}
+
+
+/**
+ * Shot tree
+ */
+
+std::vector<uint64_t> qpragma::shor::sample_phases(
+    std::span<const chain_step> chain, uint64_t N_value, uint64_t size, uint64_t nb_shots, random_stream & stream,
+    const std::shared_ptr<emulator_session> & session
+) {
+    // A node of the tree is a state shared by "nb_shots" shots, the first "idx" bits of
+    // these shots being equal to "measurement"
+    struct node {
+        statevector state;
+        uint64_t idx;
+        uint64_t measurement;
+        uint64_t nb_shots;
+    };
+
+    if (chain.size() > max_measured_bits) {
+        throw std::out_of_range("Could not sample the phases - measurements of more than 63 bits");
+    }
+
+    std::vector<uint64_t> result;
+    std::vector<node> nodes;
+
+    result.reserve(nb_shots);
+    nodes.push_back(node { statevector(size, session), 0UL, 0UL, nb_shots });
+
+    while (not nodes.empty()) {
+        node current = std::move(nodes.back());
+        nodes.pop_back();
+
+        for (; current.idx < chain.size(); ++current.idx) {
+            const chain_step & step = chain[current.idx];
+            const uint64_t bit = 1UL << current.idx;
+
+            // Leading identities always measure 0
+            if (not uses_control(step, current.measurement)) {
+                continue;
+            }
+
+            // Split the shots between both outcomes
+            double angle = correction_angle(current.measurement, current.idx);
+            double probability = std::clamp(current.state.probability(step, N_value, angle), 0., 1.);
+            uint64_t nb_zeros = 0UL;
+
+            for (uint64_t shot = 0UL; shot < current.nb_shots; ++shot) {
+                nb_zeros += stream.canonical() < probability ? 1UL : 0UL;
+            }
+
+            // Shots diverge: the state of the shots measuring 1 is projected in a new state
+            if (nb_zeros != 0UL and nb_zeros != current.nb_shots) {
+                nodes.push_back(node {
+                    current.state.projection(step, N_value, angle, true, 1. - probability),
+                    current.idx + 1UL, current.measurement | bit, current.nb_shots - nb_zeros
+                });
+
+                current.nb_shots = nb_zeros;
+            }
+
+            if (nb_zeros == 0UL) {
+                current.state.project(step, N_value, angle, true, 1. - probability);
+                current.measurement |= bit;
+            }
+
+            else {
+                current.state.project(step, N_value, angle, false, probability);
+            }
+        }
+
+        result.insert(result.end(), current.nb_shots, current.measurement);
+    }
+
+    // Shots of a leaf are consecutive: they are shuffled (Fisher-Yates)
+    for (uint64_t idx = result.size(); idx > 1UL; --idx) {
+        std::swap(result[idx - 1UL], result[stream.uniform(0UL, idx - 1UL)]);
+    }
+
+    return result;
+}
+
+
+std::vector<uint64_t> qpragma::shor::sample_phases(
+    std::span<const chain_step> chain, uint64_t N_value, uint64_t size, uint64_t nb_shots, random_stream & stream,
+    const storage_options & storage, const engine_options & engine
+) {
+    return sample_phases(chain, N_value, size, nb_shots, stream, std::make_shared<emulator_session>(storage, engine));
+}
@@ -0,0 +1,552 @@
+#include "qpragma/shor/engine.h"
+
+#include <utility>
+#include <algorithm>
+
+#include "qpragma/shor/continued_fraction.h"
+
+
+/**
+ * Internal functions
+ */
+
+// Next index gathered (y -> inverse y mod N walks the register with a constant stride)
+inline uint64_t next_source(uint64_t source, uint64_t inverse, uint64_t N_value) {
+    return source + inverse < N_value ? source + inverse : source + inverse - N_value;
+}
+
+
+// Stream the blocks of a storage: "function(first, last)" processes the amplitudes [first, last).
+// If the storage is out-of-core, "prefetch(first, last)" loads the next block on the prefetch thread
+template <typename PREFETCH, typename FUNCTION>
+void stream_blocks(
+    const qpragma::shor::amplitude_storage & storage, qpragma::shor::prefetch_thread & thread, PREFETCH prefetch, FUNCTION function
+) {
+    const uint64_t size = storage.size();
+    const uint64_t block_size = storage.block_size();
+    const bool out_of_core = storage.out_of_core();
+
+    if (out_of_core) {
+        thread.submit([&prefetch, size, block_size]() { prefetch(0UL, std::min(block_size, size)); });
+    }
+
+    try {
+        for (uint64_t first = 0UL; first < size; first += block_size) {
+            uint64_t last = std::min(first + block_size, size);
+
+            if (out_of_core) {
+                thread.wait();
+
+                if (last < size) {
+                    thread.submit([&prefetch, size, block_size, last]() { prefetch(last, std::min(last + block_size, size)); });
+                }
+            }
+
+            function(first, last);
+        }
+    }
+
+    catch (...) {
+        // The pending prefetch reads the storage: it is done before the storage can be released
+        try {
+            thread.wait();
+        }
+
+        catch (...) {}
+
+        throw;
+    }
+}
+
+
+// Amplitudes of a page (pages are 4 KiB at least)
+constexpr uint64_t page_amplitudes = 4096UL / sizeof(qpragma::shor::amplitude);
+
+
+// Load the amplitudes read to compute [first, last): the block is loaded, the amplitudes it gathers
+// are only advised (they are faulted in by the computation, reading them here would double the
+// random accesses). Close sources are advised at once, at most one hint per page of the block
+inline void prefetch_gather(
+    const qpragma::shor::amplitude_storage & storage, uint64_t inverse, uint64_t N_value, uint64_t first, uint64_t last
+) {
+    storage.prefetch(first, last - first);
+
+    if (first >= N_value) {
+        return;
+    }
+
+    uint64_t source = qpragma::shor::mul_mod(inverse, first, N_value);
+    uint64_t run_first = source;
+    uint64_t run_last = source;
+    uint64_t nb_hints = (last - first) / page_amplitudes + 1UL;
+
+    for (uint64_t idx = first + 1UL; idx < std::min(last, N_value) and nb_hints > 1UL; ++idx) {
+        source = next_source(source, inverse, N_value);
+
+        if (source + page_amplitudes >= run_first and source <= run_last + page_amplitudes) {
+            run_first = std::min(run_first, source);
+            run_last = std::max(run_last, source);
+            continue;
+        }
+
+        storage.advise(run_first, run_last - run_first + 1UL);
+        run_first = source;
+        run_last = source;
+        --nb_hints;
+    }
+
+    storage.advise(run_first, run_last - run_first + 1UL);
+}
+
+
+// Gather the amplitudes psi[inverse y mod N] for y in [first, last), with last <= N
+inline void gather(
+    const qpragma::shor::amplitude * __restrict input, qpragma::shor::amplitude * __restrict buffer,
+    uint64_t inverse, uint64_t N_value, uint64_t first, uint64_t last
+) {
+    uint64_t source = qpragma::shor::mul_mod(inverse, first, N_value);
+
+    for (uint64_t idx = first; idx < last; ++idx) {
+        buffer[idx - first] = input[source];
+        source = next_source(source, inverse, N_value);
+    }
+}
+
+
+// output[k] = (input[k] + phase * gathered[k]) * scale
+// Amplitudes are processed as interleaved (real, imaginary) doubles: the loop is vectorized using
+// OpenMP SIMD in optimized builds (the product of std::complex is not, it handles infinities and NaNs)
+inline void combine_tile(
+    const qpragma::shor::amplitude * input, const qpragma::shor::amplitude * gathered, qpragma::shor::amplitude * output,
+    uint64_t count, qpragma::shor::amplitude phase, double scale
+) {
+    const double * __restrict x_values = reinterpret_cast<const double *>(input);
+    const double * __restrict g_values = reinterpret_cast<const double *>(gathered);
+    double * __restrict o_values = reinterpret_cast<double *>(output);
+    const double phase_real = phase.real() * scale;
+    const double phase_imag = phase.imag() * scale;
+
+    #pragma omp simd
+    for (uint64_t idx = 0UL; idx < 2UL * count; idx += 2UL) {
+        o_values[idx] = x_values[idx] * scale + phase_real * g_values[idx] - phase_imag * g_values[idx + 1UL];
+        o_values[idx + 1UL] = x_values[idx + 1UL] * scale + phase_real * g_values[idx + 1UL] + phase_imag * g_values[idx];
+    }
+}
+
+
+// Sum of |input[k] + phase * gathered[k]|^2 (a SIMD reduction, one partial sum per lane)
+inline double norm_tile(
+    const qpragma::shor::amplitude * input, const qpragma::shor::amplitude * gathered, uint64_t count, qpragma::shor::amplitude phase
+) {
+    const double * __restrict x_values = reinterpret_cast<const double *>(input);
+    const double * __restrict g_values = reinterpret_cast<const double *>(gathered);
+    const double phase_real = phase.real();
+    const double phase_imag = phase.imag();
+    double sum = 0.;
+
+    #pragma omp simd reduction(+: sum)
+    for (uint64_t idx = 0UL; idx < 2UL * count; idx += 2UL) {
+        double real = x_values[idx] + phase_real * g_values[idx] - phase_imag * g_values[idx + 1UL];
+        double imag = x_values[idx + 1UL] + phase_real * g_values[idx + 1UL] + phase_imag * g_values[idx];
+        sum += real * real + imag * imag;
+    }
+
+    return sum;
+}
+
+
+/**
+ * Thread pool
+ */
+
+// Constructor and destructor
+qpragma::shor::thread_pool::thread_pool(uint64_t nb_threads) {
+    for (uint64_t idx = 1UL; idx < std::max(nb_threads, uint64_t(1UL)); ++idx) {
+        _workers.emplace_back(&thread_pool::_work, this, idx);
+    }
+}
+
+
+qpragma::shor::thread_pool::~thread_pool() {
+    {
+        std::lock_guard lock(_mutex);
+        _stop = true;
+    }
+
+    _start.notify_all();
+
+    for (auto & worker: _workers) {
+        worker.join();
+    }
+}
+
+
+// Getters
+uint64_t qpragma::shor::thread_pool::size() const {
+    return _workers.size() + 1UL;
+}
+
+
+// Execute a function on each thread
+void qpragma::shor::thread_pool::run(const std::function<void(uint64_t)> & function) {
+    {
+        std::lock_guard lock(_mutex);
+        _function = &function;
+        _nb_running = _workers.size();
+        ++_generation;
+    }
+
+    _start.notify_all();
+
+    // Workers use the function: they are waited for even if the calling thread throws
+    std::exception_ptr error;
+
+    try {
+        function(0UL);
+    }
+
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    std::unique_lock lock(_mutex);
+    _done.wait(lock, [this]() { return _nb_running == 0UL; });
+    _function = nullptr;
+
+    if (not error) {
+        error = _error;
+    }
+
+    _error = nullptr;
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+
+// Loop of a worker
+void qpragma::shor::thread_pool::_work(uint64_t thread_idx) {
+    uint64_t generation = 0UL;
+
+    while (true) {
+        const std::function<void(uint64_t)> * function;
+
+        {
+            std::unique_lock lock(_mutex);
+            _start.wait(lock, [&]() { return _stop or _generation != generation; });
+
+            if (_stop) {
+                return;
+            }
+
+            generation = _generation;
+            function = _function;
+        }
+
+        std::exception_ptr error;
+
+        try {
+            (*function)(thread_idx);
+        }
+
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard lock(_mutex);
+
+            if (error and not _error) {
+                _error = error;
+            }
+
+            --_nb_running;
+        }
+
+        _done.notify_one();
+    }
+}
+
+
+/**
+ * Prefetch thread
+ */
+
+// Destructor
+qpragma::shor::prefetch_thread::~prefetch_thread() {
+    if (not _worker.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _stop = true;
+    }
+
+    _start.notify_one();
+    _worker.join();
+}
+
+
+// Start a task, the thread is created by the first one
+void qpragma::shor::prefetch_thread::submit(std::function<void()> task) {
+    {
+        std::lock_guard lock(_mutex);
+        _task = std::move(task);
+        _pending = true;
+    }
+
+    if (not _worker.joinable()) {
+        _worker = std::thread(&prefetch_thread::_work, this);
+    }
+
+    _start.notify_one();
+}
+
+
+// Wait for the pending task
+void qpragma::shor::prefetch_thread::wait() {
+    std::unique_lock lock(_mutex);
+    _done.wait(lock, [this]() { return not _pending; });
+
+    if (_error) {
+        std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+}
+
+
+// Loop of the thread
+void qpragma::shor::prefetch_thread::_work() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock lock(_mutex);
+            _start.wait(lock, [this]() { return _stop or _task; });
+
+            if (_stop) {
+                return;
+            }
+
+            task = std::exchange(_task, nullptr);
+        }
+
+        std::exception_ptr error;
+
+        try {
+            task();
+        }
+
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard lock(_mutex);
+            _error = error;
+            _pending = false;
+        }
+
+        _done.notify_one();
+    }
+}
+
+
+/**
+ * Statevector engine
+ */
+
+void qpragma::shor::statevector_engine::fill_zeros(amplitude_storage & output) {
+    std::fill(output.data(), output.data() + output.size(), amplitude(0., 0.));
+}
+
+
+void qpragma::shor::statevector_engine::copy(const amplitude_storage & input, amplitude_storage & output) {
+    std::copy(input.data(), input.data() + input.size(), output.data());
+}
+
+
+/**
+ * Reference engine
+ */
+
+double qpragma::shor::reference_engine::norm(const amplitude_storage & input, uint64_t inverse, uint64_t N_value, amplitude phase) {
+    const amplitude * data = input.data();
+    double result = 0.;
+
+    auto prefetch = [&input, inverse, N_value](uint64_t first, uint64_t last) {
+        prefetch_gather(input, inverse, N_value, first, last);
+    };
+
+    stream_blocks(input, _prefetch, prefetch, [&](uint64_t first, uint64_t last) {
+        uint64_t source = first < N_value ? qpragma::shor::mul_mod(inverse, first, N_value) : 0UL;
+
+        for (uint64_t idx = first; idx < std::min(last, N_value); ++idx) {
+            result += std::norm(data[idx] + phase * data[source]);
+            source = next_source(source, inverse, N_value);
+        }
+
+        for (uint64_t idx = std::max(first, N_value); idx < last; ++idx) {
+            result += std::norm(data[idx] * (1. + phase));
+        }
+    });
+
+    return result;
+}
+
+
+void qpragma::shor::reference_engine::combine(
+    const amplitude_storage & input, amplitude_storage & output, uint64_t inverse, uint64_t N_value, amplitude phase, double scale
+) {
+    const amplitude * data = input.data();
+    amplitude * result = output.data();
+
+    auto prefetch = [&input, inverse, N_value](uint64_t first, uint64_t last) {
+        prefetch_gather(input, inverse, N_value, first, last);
+    };
+
+    stream_blocks(input, _prefetch, prefetch, [&](uint64_t first, uint64_t last) {
+        uint64_t source = first < N_value ? qpragma::shor::mul_mod(inverse, first, N_value) : 0UL;
+
+        for (uint64_t idx = first; idx < std::min(last, N_value); ++idx) {
+            result[idx] = (data[idx] + phase * data[source]) * scale;
+            source = next_source(source, inverse, N_value);
+        }
+
+        for (uint64_t idx = std::max(first, N_value); idx < last; ++idx) {
+            result[idx] = data[idx] * (1. + phase) * scale;
+        }
+    });
+}
+
+
+/**
+ * Parallel engine
+ */
+
+// Constructor
+qpragma::shor::parallel_engine::parallel_engine(const engine_options & options):
+    _pool(options.nb_threads == 0UL ? std::max(1U, std::thread::hardware_concurrency()) : options.nb_threads),
+    _tile_size(std::max(options.tile_size, uint64_t(1UL))),
+    _buffers(_pool.size())
+{}
+
+
+// Split the tiles of [first, last) in contiguous ranges, one per thread
+void qpragma::shor::parallel_engine::_parallel_for(
+    uint64_t first, uint64_t last, const std::function<void(uint64_t, uint64_t, uint64_t)> & function
+) {
+    const uint64_t nb_tiles = (last - first + _tile_size - 1UL) / _tile_size;
+    const uint64_t tiles_per_thread = (nb_tiles + _pool.size() - 1UL) / _pool.size();
+
+    _pool.run([&](uint64_t thread_idx) {
+        uint64_t begin = std::min(first + thread_idx * tiles_per_thread * _tile_size, last);
+        uint64_t end = std::min(begin + tiles_per_thread * _tile_size, last);
+
+        for (uint64_t tile = begin; tile < end; tile += _tile_size) {
+            function(thread_idx, tile, std::min(tile + _tile_size, end));
+        }
+    });
+}
+
+
+// Zeros and copies are written by the threads processing the amplitudes (first touch)
+void qpragma::shor::parallel_engine::fill_zeros(amplitude_storage & output) {
+    _parallel_for(0UL, output.size(), [&](uint64_t, uint64_t first, uint64_t last) {
+        std::fill(output.data() + first, output.data() + last, amplitude(0., 0.));
+    });
+}
+
+
+void qpragma::shor::parallel_engine::copy(const amplitude_storage & input, amplitude_storage & output) {
+    _parallel_for(0UL, input.size(), [&](uint64_t, uint64_t first, uint64_t last) {
+        std::copy(input.data() + first, input.data() + last, output.data() + first);
+    });
+}
+
+
+// Kernels
+double qpragma::shor::parallel_engine::norm(const amplitude_storage & input, uint64_t inverse, uint64_t N_value, amplitude phase) {
+    const amplitude * data = input.data();
+    std::vector<double> sums(_pool.size(), 0.);
+
+    auto prefetch = [&input, inverse, N_value](uint64_t first, uint64_t last) {
+        prefetch_gather(input, inverse, N_value, first, last);
+    };
+
+    stream_blocks(input, _prefetch, prefetch, [&](uint64_t block_first, uint64_t block_last) {
+        _parallel_for(block_first, block_last, [&](uint64_t thread_idx, uint64_t first, uint64_t last) {
+            std::vector<amplitude> & buffer = _buffers[thread_idx];
+            buffer.resize(_tile_size);
+
+            // Neighbouring partial sums share a cache line: each tile only writes its own once
+            double sum = 0.;
+
+            if (first < N_value) {
+                uint64_t middle = std::min(last, N_value);
+                gather(data, buffer.data(), inverse, N_value, first, middle);
+                sum += norm_tile(data + first, buffer.data(), middle - first, phase);
+            }
+
+            if (last > N_value) {
+                uint64_t middle = std::max(first, N_value);
+                sum += norm_tile(data + middle, data + middle, last - middle, phase);
+            }
+
+            sums[thread_idx] += sum;
+        });
+    });
+
+    // Partial sums are added in a fixed order: the result does not depend on the scheduling
+    double result = 0.;
+
+    for (double sum: sums) {
+        result += sum;
+    }
+
+    return result;
+}
+
+
+void qpragma::shor::parallel_engine::combine(
+    const amplitude_storage & input, amplitude_storage & output, uint64_t inverse, uint64_t N_value, amplitude phase, double scale
+) {
+    const amplitude * data = input.data();
+    amplitude * result = output.data();
+
+    auto prefetch = [&input, inverse, N_value](uint64_t first, uint64_t last) {
+        prefetch_gather(input, inverse, N_value, first, last);
+    };
+
+    stream_blocks(input, _prefetch, prefetch, [&](uint64_t block_first, uint64_t block_last) {
+        _parallel_for(block_first, block_last, [&](uint64_t thread_idx, uint64_t first, uint64_t last) {
+            std::vector<amplitude> & buffer = _buffers[thread_idx];
+            buffer.resize(_tile_size);
+
+            if (first < N_value) {
+                uint64_t middle = std::min(last, N_value);
+                gather(data, buffer.data(), inverse, N_value, first, middle);
+                combine_tile(data + first, buffer.data(), result + first, middle - first, phase, scale);
+            }
+
+            if (last > N_value) {
+                uint64_t middle = std::max(first, N_value);
+                combine_tile(data + middle, data + middle, result + middle, last - middle, phase, scale);
+            }
+        });
+    });
+}
+
+
+/**
+ * Factory
+ */
+
+std::shared_ptr<qpragma::shor::statevector_engine> qpragma::shor::make_engine(const engine_options & options) {
+    if (options.engine == emulator_engine::parallel) {
+        return std::make_shared<parallel_engine>(options);
+    }
+
+    return std::make_shared<reference_engine>();
+}
@@ -0,0 +1,152 @@
+#include "qpragma/shor/lattice.h"
+
+#include <bit>
+#include <cmath>
+#include <utility>
+#include <stdexcept>
+
+#include "qpragma/shor/continued_fraction.h"
+
+
+/**
+ * Internal functions
+ */
+
+// Largest number of exponent bits (vectors of the reduced basis fit in 64 bits integers)
+constexpr uint64_t max_lattice_bits = 48UL;
+
+
+// Gram-Schmidt orthogonalization: squared norms of the orthogonal vectors and coefficients mu
+void gram_schmidt(
+    const std::vector<std::vector<int64_t>> & basis, std::vector<long double> & norms, std::vector<std::vector<long double>> & mu
+) {
+    const uint64_t dimension = basis.size();
+    std::vector<std::vector<long double>> orthogonal(dimension);
+
+    for (uint64_t row = 0UL; row < dimension; ++row) {
+        orthogonal[row].assign(basis[row].begin(), basis[row].end());
+
+        for (uint64_t previous = 0UL; previous < row; ++previous) {
+            long double product = 0.L;
+
+            for (uint64_t col = 0UL; col < basis[row].size(); ++col) {
+                product += static_cast<long double>(basis[row][col]) * orthogonal[previous][col];
+            }
+
+            mu[row][previous] = norms[previous] == 0.L ? 0.L : product / norms[previous];
+
+            for (uint64_t col = 0UL; col < basis[row].size(); ++col) {
+                orthogonal[row][col] -= mu[row][previous] * orthogonal[previous][col];
+            }
+        }
+
+        norms[row] = 0.L;
+
+        for (long double value: orthogonal[row]) {
+            norms[row] += value * value;
+        }
+    }
+}
+
+
+/**
+ * LLL reduction
+ */
+
+void qpragma::shor::lll_reduce(std::vector<std::vector<int64_t>> & basis, double delta) {
+    const uint64_t dimension = basis.size();
+    std::vector<long double> norms(dimension);
+    std::vector<std::vector<long double>> mu(dimension, std::vector<long double>(dimension, 0.L));
+
+    // The orthogonalization is recomputed after each update of the basis: the dimension is small,
+    // and rounding errors do not accumulate
+    gram_schmidt(basis, norms, mu);
+
+    for (uint64_t row = 1UL; row < dimension;) {
+        // Size reduction
+        for (uint64_t previous = row; previous-- > 0UL;) {
+            if (auto quotient = static_cast<int64_t>(std::llround(mu[row][previous])); quotient != 0) {
+                for (uint64_t col = 0UL; col < basis[row].size(); ++col) {
+                    basis[row][col] -= quotient * basis[previous][col];
+                }
+
+                gram_schmidt(basis, norms, mu);
+            }
+        }
+
+        // Lovász condition
+        if (norms[row] >= (delta - mu[row][row - 1UL] * mu[row][row - 1UL]) * norms[row - 1UL]) {
+            ++row;
+        }
+
+        else {
+            std::swap(basis[row], basis[row - 1UL]);
+            gram_schmidt(basis, norms, mu);
+            row = std::max(row - 1UL, uint64_t(1UL));
+        }
+    }
+}
+
+
+/**
+ * Lattice post-processing
+ */
+
+// Number of runs
+uint64_t qpragma::shor::lattice_runs(uint64_t size, uint64_t nb_bits) {
+    if (nb_bits <= size or nb_bits > max_lattice_bits) {
+        throw std::out_of_range("Could not combine runs - the number of exponent bits should be between SIZE + 1 and 48");
+    }
+
+    const uint64_t extra_bits = nb_bits - size;
+    return (size + extra_bits - 1UL) / extra_bits + 1UL;
+}
+
+
+// Post-process runs
+qpragma::shor::attempt_result qpragma::shor::post_process_runs(
+    std::span<const uint64_t> measurements, uint64_t nb_bits, uint64_t base, uint64_t N_value, const deadline & limit
+) {
+    if (nb_bits == 0UL or nb_bits > max_lattice_bits) {
+        throw std::out_of_range("Could not combine runs - unsupported number of exponent bits");
+    }
+
+    // Basis: (1, j_1, ..., j_n) and 2^nb_bits e_i
+    const uint64_t dimension = measurements.size() + 1UL;
+    std::vector<std::vector<int64_t>> basis(dimension, std::vector<int64_t>(dimension, 0));
+    basis[0][0] = 1;
+
+    for (uint64_t idx = 0UL; idx < measurements.size(); ++idx) {
+        basis[0][idx + 1UL] = static_cast<int64_t>(measurements[idx]);
+        basis[idx + 1UL][idx + 1UL] = static_cast<int64_t>(1UL << nb_bits);
+    }
+
+    lll_reduce(basis);
+
+    // The smallest first coordinate (or a small multiple of it) which is a multiple of the order
+    const uint64_t max_multiple = std::bit_width(N_value);
+    uint64_t order = 0UL;
+
+    for (const auto & vector: basis) {
+        if (limit.expired()) {
+            break;
+        }
+
+        uint64_t first = static_cast<uint64_t>(vector[0] < 0 ? -vector[0] : vector[0]);
+
+        for (uint64_t multiple = 1UL; multiple <= max_multiple and first != 0UL; ++multiple) {
+            uint64_t candidate = multiple * first;
+
+            if (candidate >= N_value or (order != 0UL and candidate >= order)) {
+                break;
+            }
+
+            if (pow_mod(base, candidate, N_value) == 1UL) {
+                order = candidate;
+                break;
+            }
+        }
+    }
+
+    return process_order(base, order, N_value, limit);
+}
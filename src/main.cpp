@@ -1,5 +1,11 @@
 // Include C++ stdlib (and boost)
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <string>
 #include <optional>
+#include <stdexcept>
+#include <algorithm>
 #include <iostream>
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
@@ -18,6 +24,7 @@ using boost::program_options::options_description;
 using boost::program_options::parse_command_line;
 using boost::program_options::variables_map;
 using boost::program_options::bool_switch;
+using boost::program_options::value;
 
 // Use Q-Pragma
 using qpragma::shor::fraction;
@@ -28,6 +35,19 @@ using qpragma::shor::pretty_display;
 // Useful classes
 struct Configuration {
     bool quantum_only = false;
+    std::string cache_path;
+    std::string trace_path;
+    bool estimate = false;
+    uint64_t deadline_ms = 0UL;
+    std::string multiplier = "qpragma";
+    uint64_t shots = 1UL;
+    std::string out_of_core = "";
+    std::string engine = "reference";
+    uint64_t threads = 0UL;
+    uint64_t classical_below = 0UL;
+    uint64_t exponent_bits = 0UL;
+    std::string cost_model_path = "";
+    bool validate = false;
 };
 
 
@@ -41,6 +61,19 @@ std::optional<Configuration> parse_arguments(int argc, char ** argv) {
     options.add_options()
         ("help,h", bool_switch()->default_value(false), "Display help")
         ("quantum-only,q", bool_switch()->default_value(false), "Ignore cases where the algorithm finds a solution classically")
+        ("cache,c", value<std::string>()->default_value(""), "Persistent cache of orders and factorizations (file path)")
+        ("record,r", value<std::string>()->default_value(""), "Record every attempt in a trace (file path), see qpragma-shor-replay")
+        ("estimate,e", bool_switch()->default_value(false), "Estimate resources needed to divide the number, without simulation")
+        ("deadline-ms,d", value<uint64_t>()->default_value(0UL), "Time budget of the factorization in milliseconds (0 means no deadline)")
+        ("multiplier,m", value<std::string>()->default_value("qpragma"), "Modular multiplier of the Q-Pragma scope (not used with --shots): qpragma, draper, ripple-carry or auto (cheapest emulation cost)")
+        ("shots,k", value<uint64_t>()->default_value(1UL), "Number of measurements sampled per base (emulated, sharing common prefixes)")
+        ("out-of-core,o", value<std::string>()->default_value(""), "Store emulated amplitudes in memory-mapped files of this directory (used with --shots)")
+        ("engine,g", value<std::string>()->default_value("reference"), "Statevector engine (used with --shots): reference or parallel")
+        ("threads,t", value<uint64_t>()->default_value(0UL), "Number of threads of the parallel engine (0 means one per hardware thread)")
+        ("classical-below,b", value<uint64_t>()->default_value(0UL), "Compute orders classically for numbers lower than this threshold (0 means never)")
+        ("exponent-bits,x", value<uint64_t>()->default_value(0UL), "Exponent bits of a run, shorter runs are combined using a lattice (0 means 2 * size)")
+        ("autotune,a", value<std::string>()->default_value(""), "Choose the strategy using the cost model of this machine (file path, calibrated if missing)")
+        ("validate,v", bool_switch()->default_value(false), "Check that every order found by the post-processing is minimal (slower)")
         ;
 
     // Parse arguments
@@ -53,12 +86,158 @@ std::optional<Configuration> parse_arguments(int argc, char ** argv) {
         return std::nullopt;
     }
 
+    // Several shots are sampled on the statevector emulator, which applies the multiplications
+    // analytically: a multiplier would be silently ignored
+    if (parsed_arguments["shots"].as<uint64_t>() > 1UL and not parsed_arguments["multiplier"].defaulted()) {
+        std::cout << YELLOW "ERROR - --multiplier cannot be used with --shots greater than 1" NOCOLOR << std::endl;
+        return std::nullopt;
+    }
+
+    // The cost model chooses the options of the emulator: explicit options would be silently replaced
+    if (not parsed_arguments["autotune"].defaulted()) {
+        for (const char * option: { "shots", "out-of-core", "engine", "threads" }) {
+            if (not parsed_arguments[option].defaulted()) {
+                std::cout << YELLOW "ERROR - --" << option << " cannot be used with --autotune" NOCOLOR << std::endl;
+                return std::nullopt;
+            }
+        }
+    }
+
     return Configuration {
-        .quantum_only = parsed_arguments["quantum-only"].as<bool>()
+        .quantum_only = parsed_arguments["quantum-only"].as<bool>(),
+        .cache_path = parsed_arguments["cache"].as<std::string>(),
+        .trace_path = parsed_arguments["record"].as<std::string>(),
+        .estimate = parsed_arguments["estimate"].as<bool>(),
+        .deadline_ms = parsed_arguments["deadline-ms"].as<uint64_t>(),
+        .multiplier = parsed_arguments["multiplier"].as<std::string>(),
+        .shots = parsed_arguments["shots"].as<uint64_t>(),
+        .out_of_core = parsed_arguments["out-of-core"].as<std::string>(),
+        .engine = parsed_arguments["engine"].as<std::string>(),
+        .threads = parsed_arguments["threads"].as<uint64_t>(),
+        .classical_below = parsed_arguments["classical-below"].as<uint64_t>(),
+        .exponent_bits = parsed_arguments["exponent-bits"].as<uint64_t>(),
+        .cost_model_path = parsed_arguments["autotune"].as<std::string>(),
+        .validate = parsed_arguments["validate"].as<bool>()
     };
 }
 
 
+/**
+ * Execute Shor algorithm (or estimate its resources) using a given multiplier
+ */
+template <uint64_t SIZE, typename MULTIPLIER>
+int shor(uint64_t to_divide, const Configuration & configuration) {
+    // Estimate resources only
+    if (configuration.estimate) {
+        try {
+            auto estimate = qpragma::shor::estimate_resources(SIZE, to_divide, MULTIPLIER::cost(SIZE));
+            std::cout << GREEN "Resources needed to divide " << to_divide << NOCOLOR << std::endl << estimate << std::endl;
+        }
+
+        catch (const std::out_of_range & error) {
+            std::cout << YELLOW "ERROR - " << error.what() << NOCOLOR << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Open cache
+    std::unique_ptr<qpragma::shor::order_cache> cache;
+
+    if (not configuration.cache_path.empty()) {
+        cache = std::make_unique<qpragma::shor::order_cache>(configuration.cache_path);
+    }
+
+    // Open trace
+    std::unique_ptr<qpragma::shor::trace_writer> trace;
+
+    if (not configuration.trace_path.empty()) {
+        trace = std::make_unique<qpragma::shor::trace_writer>(configuration.trace_path);
+    }
+
+    qpragma::shor::find_options options {
+        .quantum_only = configuration.quantum_only,
+        .cache = cache.get(),
+        .trace = trace.get(),
+        .shots = configuration.shots,
+        .classical_threshold = configuration.classical_below,
+        .validate = configuration.validate,
+        .exponent_bits = configuration.exponent_bits
+    };
+
+    if (configuration.deadline_ms != 0UL) {
+        options.time_budget = std::chrono::milliseconds(configuration.deadline_ms);
+    }
+
+    if (not configuration.out_of_core.empty()) {
+        options.storage.backend = qpragma::shor::storage_backend::mapped;
+        options.storage.directory = configuration.out_of_core;
+    }
+
+    if (configuration.engine == "parallel") {
+        options.engine.engine = qpragma::shor::emulator_engine::parallel;
+        options.engine.nb_threads = configuration.threads;
+    }
+
+    else if (configuration.engine != "reference") {
+        std::cout << YELLOW "ERROR - Unknown engine \"" << configuration.engine << "\"" NOCOLOR << std::endl;
+        return 1;
+    }
+
+    // The cost model of this machine replaces the options of the emulator
+    if (not configuration.cost_model_path.empty()) {
+        auto model = qpragma::shor::load_or_calibrate(configuration.cost_model_path);
+        auto tuning = qpragma::shor::tune(model, SIZE, to_divide, configuration.quantum_only);
+
+        if (tuning.classical) {
+            options.classical_threshold = to_divide + 1UL;
+            std::cout << CYAN "Autotune: classical order finder (expected " << tuning.expected_ms << " ms)" NOCOLOR << std::endl;
+        }
+
+        else {
+            options.shots = tuning.shots;
+            options.session = std::make_shared<qpragma::shor::emulator_session>(tuning.storage, tuning.engine);
+            std::cout << CYAN "Autotune: "
+                      << (tuning.engine.engine == qpragma::shor::emulator_engine::parallel ? "parallel engine" : "reference engine")
+                      << " (" << std::max(1UL, tuning.engine.nb_threads) << " thread(s)), " << tuning.shots << " shot(s) per base"
+                      << (tuning.storage.backend == qpragma::shor::storage_backend::mapped ? ", out-of-core" : "")
+                      << " (expected " << tuning.expected_ms << " ms)" NOCOLOR << std::endl;
+        }
+    }
+
+    qpragma::shor::divisor_result result;
+
+    try {
+        result = qpragma::shor::find_factors<SIZE, MULTIPLIER>(to_divide, options);
+    }
+
+    catch (const std::logic_error & error) {
+        std::cout << YELLOW "ERROR - " << error.what() << NOCOLOR << std::endl;
+        return 1;
+    }
+
+    if (result.status == qpragma::shor::divisor_status::found) {
+        uint64_t divisor = result.factors.front();
+        std::cout << GREEN "Find a divisor: " << divisor << NOCOLOR << std::endl;
+        std::cout << " > " << to_divide << " = " << divisor << " * " << (to_divide / divisor) << std::endl;
+    }
+
+    else if (result.status == qpragma::shor::divisor_status::partial) {
+        std::cout << YELLOW "TIMEOUT - Deadline expired after " << result.attempts << " attempt(s)" NOCOLOR << std::endl;
+        std::cout << " > Factors found: " << std::vector<int64_t>(result.factors.begin(), result.factors.end()) << std::endl;
+        std::cout << " > Bases ruled out: " << std::vector<int64_t>(result.ruled_out_bases.begin(), result.ruled_out_bases.end()) << std::endl;
+        return 2;
+    }
+
+    else {
+        std::cout << YELLOW "ERROR - No divisor found" NOCOLOR << std::endl;
+    }
+
+    return 0;
+}
+
+
 /**
  * Main function.
  * Execute Shor algorithm
@@ -78,19 +257,24 @@ int main(int argc, char ** argv) {
     uint64_t to_divide = 0UL;
 
     do {
-        std::cout << CYAN "Please insert a number to divide (needs to be greater than 3 and lower than " << ((1UL << size) - 1UL) << ")" NOCOLOR
+        std::cout << CYAN "Please insert a number to divide (needs to be at least 3 and lower than " << (1UL << size) << ")" NOCOLOR
                   << std::endl << "Number: ";
         std::cin >> to_divide;
-    } while (to_divide > (1UL << size) or to_divide < 3UL);
+    } while (to_divide >= (1UL << size) or to_divide < 3UL);
 
-    auto result = qpragma::shor::find_divisor<size>(to_divide, configuration->quantum_only);
+    // Execute Shor using the selected multiplier
+    if (configuration->multiplier == "auto")
+        return shor<size, qpragma::shor::cheapest_multiplier<size>>(to_divide, *configuration);
 
-    if (result) {
-        std::cout << GREEN "Find a divisor: " << result << NOCOLOR << std::endl;
-        std::cout << " > " << to_divide << " = " << result << " * " << (to_divide / result) << std::endl;
-    }
+    if (configuration->multiplier == "qpragma")
+        return shor<size, qpragma::shor::qpragma_multiplier>(to_divide, *configuration);
 
-    else {
-        std::cout << YELLOW "ERROR - No divisor found" NOCOLOR << std::endl;
-    }
+    if (configuration->multiplier == "draper")
+        return shor<size, qpragma::shor::draper_multiplier>(to_divide, *configuration);
+
+    if (configuration->multiplier == "ripple-carry")
+        return shor<size, qpragma::shor::ripple_carry_multiplier>(to_divide, *configuration);
+
+    std::cout << YELLOW "ERROR - Unknown multiplier \"" << configuration->multiplier << "\"" NOCOLOR << std::endl;
+    return 1;
 }
@@ -0,0 +1,263 @@
+// Include C++ stdlib (and boost)
+#include <chrono>
+#include <string>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <iostream>
+#include <algorithm>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <boost/program_options/options_description.hpp>
+
+// Include Q-Pragma
+#include "qpragma/shor.h"
+
+#define GREEN   "\x1B[32m"
+#define YELLOW  "\x1B[33m"
+#define CYAN    "\x1B[36m"
+#define NOCOLOR "\x1B[0m"
+
+// Use Boost
+using boost::program_options::options_description;
+using boost::program_options::parse_command_line;
+using boost::program_options::variables_map;
+using boost::program_options::bool_switch;
+using boost::program_options::value;
+
+// Sizes of quantum register supported by the Q-Pragma scope (the size is a template argument).
+// The scope emulates the control qubit, the register and the ancillas of the multiplier
+// (27 qubits for a register of 12 qubits): larger registers only compare the engines
+constexpr uint64_t min_scope_size = 4UL;
+constexpr uint64_t max_scope_size = 12UL;
+
+// Sizes of quantum register supported by the statevector engines: measurements of 2 * size bits
+// are post-processed, they hold at most 63 bits (31 qubits, stored in memory)
+constexpr uint64_t min_size = 4UL;
+constexpr uint64_t max_size = qpragma::shor::max_measured_bits / 2UL;
+
+
+// Useful classes
+struct Configuration {
+    uint64_t min_size = 4UL;
+    uint64_t max_size = 4UL;
+    uint64_t shots = 1UL;
+    uint64_t threads = 0UL;
+    uint64_t seed = 1234UL;
+    std::string output_path;
+};
+
+
+/**
+ * Parse command line arguments
+ * This function is based on boost/program_options
+ */
+std::optional<Configuration> parse_arguments(int argc, char ** argv) {
+    // List all options
+    options_description options("Benchmark of the phase estimation on the Q-Pragma emulator, on the statevector engines and of the classical order finder");
+    options.add_options()
+        ("help,h", bool_switch()->default_value(false), "Display help")
+        ("min-size", value<uint64_t>()->default_value(min_size), "Minimal size of the quantum register")
+        ("max-size", value<uint64_t>()->default_value(16UL), "Maximal size of the quantum register")
+        ("shots,k", value<uint64_t>()->default_value(1UL), "Number of measurements sampled per size")
+        ("threads,t", value<uint64_t>()->default_value(std::max(1U, std::thread::hardware_concurrency())), "Number of threads of the parallel engine")
+        ("seed,s", value<uint64_t>()->default_value(1234UL), "Seed of the benchmark")
+        ("output,o", value<std::string>()->default_value(""), "CSV output (file path) - standard output by default")
+        ;
+
+    // Parse arguments
+    variables_map parsed_arguments;
+    store(parse_command_line(argc, argv, options), parsed_arguments);
+
+    // Create configuration
+    if (parsed_arguments["help"].as<bool>()) {
+        std::cout << options;
+        return std::nullopt;
+    }
+
+    Configuration configuration {
+        .min_size = parsed_arguments["min-size"].as<uint64_t>(),
+        .max_size = parsed_arguments["max-size"].as<uint64_t>(),
+        .shots = std::max(1UL, parsed_arguments["shots"].as<uint64_t>()),
+        .threads = std::max(1UL, parsed_arguments["threads"].as<uint64_t>()),
+        .seed = parsed_arguments["seed"].as<uint64_t>(),
+        .output_path = parsed_arguments["output"].as<std::string>()
+    };
+
+    if (configuration.min_size < min_size or configuration.max_size > max_size or configuration.min_size > configuration.max_size) {
+        std::cout << YELLOW "ERROR - Sizes should be between " << min_size << " and " << max_size << NOCOLOR << std::endl;
+        return std::nullopt;
+    }
+
+    return configuration;
+}
+
+
+/**
+ * Largest number N = p * q (p and q are distinct odd primes) stored in a register of "size" qubits
+ */
+uint64_t largest_semiprime(uint64_t size) {
+    for (uint64_t N_value = (1UL << size) - 1UL; N_value > 14UL; N_value -= 2UL) {
+        uint64_t p_value = qpragma::shor::trial_division(N_value);
+
+        if (p_value != 0UL and p_value != 2UL and p_value * p_value != N_value
+                and qpragma::shor::trial_division(N_value / p_value) == 0UL) {
+            return N_value;
+        }
+    }
+
+    return 15UL;
+}
+
+
+/**
+ * Measure the duration of the phase estimation using the Q-Pragma scope
+ * Each shot executes the whole scope
+ */
+template <uint64_t SIZE>
+double scope_time_ms(uint64_t base, uint64_t N_value, uint64_t shots) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t shot = 0UL; shot < shots; ++shot) {
+        qpragma::shor::measure_phase<SIZE>(base, N_value);
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+
+template <uint64_t... SIZES>
+double scope_time_ms(uint64_t size, uint64_t base, uint64_t N_value, uint64_t shots, std::integer_sequence<uint64_t, SIZES...>) {
+    double result = 0.;
+    ((size == min_scope_size + SIZES ? (result = scope_time_ms<min_scope_size + SIZES>(base, N_value, shots), 0) : 0), ...);
+
+    return result;
+}
+
+
+/**
+ * Measure the duration of the phase estimation using a statevector engine
+ */
+double engine_time_ms(
+    uint64_t size, uint64_t base, uint64_t N_value, const Configuration & configuration, const qpragma::shor::engine_options & engine
+) {
+    auto chain = qpragma::shor::squaring_chain(base, 2UL * size, N_value);
+    qpragma::shor::random_stream stream(configuration.seed, N_value, base);
+
+    auto start = std::chrono::steady_clock::now();
+    auto measurements = qpragma::shor::sample_phases(chain, N_value, size, configuration.shots, stream, qpragma::shor::storage_options(), engine);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Orders found by the post-processing are checked (invalid orders are reported)
+    for (uint64_t measurement: measurements) {
+        if (auto attempt = qpragma::shor::post_process(measurement, 2UL * size, base, N_value); attempt.order != 0UL) {
+            try {
+                qpragma::shor::validate_order(base, attempt.order, N_value);
+            }
+
+            catch (const std::logic_error & error) {
+                std::cerr << YELLOW "WARNING - " << error.what() << NOCOLOR << std::endl;
+            }
+        }
+    }
+
+    return elapsed.count();
+}
+
+
+/**
+ * Measure the duration of the phase estimation using a session of a statevector engine
+ * Each shot is a separate attempt, like the shots of the Q-Pragma scope, but the attempts reuse
+ * the buffers and threads of the session
+ */
+double session_time_ms(
+    uint64_t size, uint64_t base, uint64_t N_value, const Configuration & configuration, const qpragma::shor::engine_options & engine
+) {
+    auto chain = qpragma::shor::squaring_chain(base, 2UL * size, N_value);
+    qpragma::shor::random_stream stream(configuration.seed, N_value, base);
+
+    auto start = std::chrono::steady_clock::now();
+    auto session = std::make_shared<qpragma::shor::emulator_session>(qpragma::shor::storage_options(), engine);
+
+    for (uint64_t shot = 0UL; shot < configuration.shots; ++shot) {
+        qpragma::shor::sample_phases(chain, N_value, size, 1UL, stream, session);
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+
+/**
+ * Measure the duration of the classical order finder
+ */
+double classical_time_ms(uint64_t base, uint64_t N_value) {
+    auto start = std::chrono::steady_clock::now();
+    qpragma::shor::classical_order(base, N_value);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    return elapsed.count();
+}
+
+
+/**
+ * Main function.
+ * Execute the benchmark and write the results in a CSV file
+ */
+int main(int argc, char ** argv) {
+    // Parse arguments
+    auto configuration = parse_arguments(argc, argv);
+
+    if (not configuration) {
+        // No arguments
+        return 1;
+    }
+
+    // Open output
+    std::ofstream output_file;
+
+    if (not configuration->output_path.empty()) {
+        output_file.open(configuration->output_path);
+    }
+
+    std::ostream & output = configuration->output_path.empty() ? std::cout : output_file;
+    output << "size,N,base,backend,threads,shots,time_ms" << std::endl;
+
+    // Execute benchmark
+    for (uint64_t size = configuration->min_size; size <= configuration->max_size; ++size) {
+        std::cerr << CYAN "Benchmark for a register of " << size << " qubits" NOCOLOR << std::endl;
+
+        uint64_t N_value = largest_semiprime(size);
+        uint64_t base = *qpragma::shor::base_scheduler(N_value, configuration->seed).next();
+
+        auto write = [&](const std::string & backend, uint64_t threads, double time_ms, uint64_t shots) {
+            output << size << "," << N_value << "," << base << "," << backend << "," << threads << ","
+                   << shots << "," << time_ms << std::endl;
+        };
+
+        if (size <= max_scope_size) {
+            double time_ms = scope_time_ms(
+                size, base, N_value, configuration->shots, std::make_integer_sequence<uint64_t, max_scope_size - min_scope_size + 1UL>()
+            );
+            write("qpragma", 1UL, time_ms, configuration->shots);
+        }
+
+        qpragma::shor::engine_options reference;
+        write("reference", 1UL, engine_time_ms(size, base, N_value, *configuration, reference), configuration->shots);
+
+        qpragma::shor::engine_options parallel {
+            .engine = qpragma::shor::emulator_engine::parallel,
+            .nb_threads = configuration->threads
+        };
+        write("parallel", configuration->threads, engine_time_ms(size, base, N_value, *configuration, parallel), configuration->shots);
+        write("session", configuration->threads, session_time_ms(size, base, N_value, *configuration, parallel), configuration->shots);
+        write("classical", 1UL, classical_time_ms(base, N_value), 1UL);
+    }
+
+    std::cerr << GREEN "Benchmark done" NOCOLOR << std::endl;
+}
@@ -0,0 +1,235 @@
+// Include C++ stdlib (and boost)
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <utility>
+#include <optional>
+#include <iostream>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <boost/program_options/options_description.hpp>
+
+// Include Q-Pragma
+#include "qpragma/shor.h"
+#include "qpragma/shor/campaign.h"
+
+#define GREEN   "\x1B[32m"
+#define YELLOW  "\x1B[33m"
+#define CYAN    "\x1B[36m"
+#define NOCOLOR "\x1B[0m"
+
+// Use Boost
+using boost::program_options::options_description;
+using boost::program_options::parse_command_line;
+using boost::program_options::variables_map;
+using boost::program_options::bool_switch;
+using boost::program_options::value;
+
+// Use Q-Pragma
+using qpragma::shor::campaign_statistics;
+
+// Sizes of quantum register supported by the campaign (the size is a template argument)
+constexpr uint64_t min_size = 4UL;
+constexpr uint64_t max_size = 8UL;
+
+// The Q-Pragma runtime does not document quantum scopes as thread-safe: scopes are executed one
+// at a time, workers only run the classical part concurrently (emulated attempts run concurrently)
+std::mutex scope_mutex;
+
+
+// Useful classes
+struct Configuration {
+    uint64_t min_size = 4UL;
+    uint64_t max_size = 4UL;
+    uint64_t attempts = 100UL;
+    uint64_t jobs = 1UL;
+    uint64_t seed = 1234UL;
+    bool emulate = false;
+    std::string output_path;
+};
+
+
+/**
+ * Parse command line arguments
+ * This function is based on boost/program_options
+ */
+std::optional<Configuration> parse_arguments(int argc, char ** argv) {
+    // List all options
+    options_description options("Monte-Carlo campaign measuring the success rate of Shor algorithm");
+    options.add_options()
+        ("help,h", bool_switch()->default_value(false), "Display help")
+        ("min-size", value<uint64_t>()->default_value(min_size), "Minimal size of the quantum register")
+        ("max-size", value<uint64_t>()->default_value(min_size), "Maximal size of the quantum register")
+        ("attempts,n", value<uint64_t>()->default_value(100UL), "Number of attempts for each number")
+        ("jobs,j", value<uint64_t>()->default_value(std::max(1U, std::thread::hardware_concurrency())), "Number of parallel workers (Q-Pragma scopes are executed one at a time, use --emulate to run attempts concurrently)")
+        ("seed,s", value<uint64_t>()->default_value(1234UL), "Seed of the campaign")
+        ("emulate,e", bool_switch()->default_value(false), "Sample the phases on the statevector emulator of this repository (one session per worker)")
+        ("output,o", value<std::string>()->default_value(""), "CSV output (file path) - standard output by default")
+        ;
+
+    // Parse arguments
+    variables_map parsed_arguments;
+    store(parse_command_line(argc, argv, options), parsed_arguments);
+
+    // Create configuration
+    if (parsed_arguments["help"].as<bool>()) {
+        std::cout << options;
+        return std::nullopt;
+    }
+
+    Configuration configuration {
+        .min_size = parsed_arguments["min-size"].as<uint64_t>(),
+        .max_size = parsed_arguments["max-size"].as<uint64_t>(),
+        .attempts = parsed_arguments["attempts"].as<uint64_t>(),
+        .jobs = std::max(1UL, parsed_arguments["jobs"].as<uint64_t>()),
+        .seed = parsed_arguments["seed"].as<uint64_t>(),
+        .emulate = parsed_arguments["emulate"].as<bool>(),
+        .output_path = parsed_arguments["output"].as<std::string>()
+    };
+
+    if (configuration.min_size < min_size or configuration.max_size > max_size or configuration.min_size > configuration.max_size) {
+        std::cout << YELLOW "ERROR - Sizes should be between " << min_size << " and " << max_size << NOCOLOR << std::endl;
+        return std::nullopt;
+    }
+
+    return configuration;
+}
+
+
+/**
+ * Run a campaign for a given size
+ * Attempts of all the numbers are distributed over the workers. Each attempt is seeded
+ * by its index: statistics do not depend on the number of workers. Emulated attempts use
+ * the session of their worker, Q-Pragma scopes are serialized
+ */
+template <uint64_t SIZE>
+std::vector<campaign_statistics> run_campaign(const Configuration & configuration) {
+    auto corpus = qpragma::shor::semiprimes(SIZE);
+    std::vector<campaign_statistics> statistics(corpus.size());
+
+    for (uint64_t idx = 0UL; idx < corpus.size(); ++idx) {
+        statistics[idx].N_value = corpus[idx];
+        statistics[idx].size = SIZE;
+    }
+
+    std::atomic<uint64_t> next_attempt = 0UL;
+    std::mutex statistics_mutex;
+    const uint64_t nb_attempts = corpus.size() * configuration.attempts;
+
+    auto worker = [&]() {
+        std::vector<campaign_statistics> local(corpus.size());
+        auto session = configuration.emulate ? std::make_shared<qpragma::shor::emulator_session>() : nullptr;
+
+        for (uint64_t idx = next_attempt++; idx < nb_attempts; idx = next_attempt++) {
+            uint64_t N_value = corpus[idx / configuration.attempts];
+            uint64_t base = qpragma::shor::campaign_base(configuration.seed, N_value, idx % configuration.attempts);
+
+            // The time spent waiting for the scope is part of the attempt: the time per attempt
+            // reflects the throughput of the workers
+            auto start = std::chrono::steady_clock::now();
+            uint64_t measurement = 0UL;
+
+            if (std::gcd(base, N_value) == 1UL and session != nullptr) {
+                // The stream of the emulator is keyed by the attempt (distinct from the stream of the base)
+                qpragma::shor::random_stream stream(~configuration.seed, N_value, idx % configuration.attempts);
+                measurement = qpragma::shor::sample_phases(
+                    qpragma::shor::squaring_chain(base, 2UL * SIZE, N_value), N_value, SIZE, 1UL, stream, session
+                ).front();
+            }
+
+            else if (std::gcd(base, N_value) == 1UL) {
+                std::lock_guard lock(scope_mutex);
+                measurement = qpragma::shor::measure_phase<SIZE>(base, N_value);
+            }
+
+            auto result = qpragma::shor::post_process(measurement, 2UL * SIZE, base, N_value);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            local[idx / configuration.attempts].record(result.outcome, elapsed.count());
+        }
+
+        std::lock_guard lock(statistics_mutex);
+
+        for (uint64_t idx = 0UL; idx < corpus.size(); ++idx) {
+            statistics[idx] += local[idx];
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    for (uint64_t idx = 0UL; idx < configuration.jobs; ++idx) {
+        workers.emplace_back(worker);
+    }
+
+    for (auto & thread: workers) {
+        thread.join();
+    }
+
+    return statistics;
+}
+
+
+/**
+ * Run a campaign for a size known at runtime
+ */
+template <uint64_t... SIZES>
+std::vector<campaign_statistics> run_campaign(uint64_t size, const Configuration & configuration, std::integer_sequence<uint64_t, SIZES...>) {
+    std::vector<campaign_statistics> result;
+    ((size == min_size + SIZES ? (result = run_campaign<min_size + SIZES>(configuration), 0) : 0), ...);
+
+    return result;
+}
+
+
+/**
+ * Main function.
+ * Execute a campaign and write the results in a CSV file
+ */
+int main(int argc, char ** argv) {
+    // Parse arguments
+    auto configuration = parse_arguments(argc, argv);
+
+    if (not configuration) {
+        // No arguments
+        return 1;
+    }
+
+    // Open output
+    std::ofstream output_file;
+
+    if (not configuration->output_path.empty()) {
+        output_file.open(configuration->output_path);
+
+        if (not output_file) {
+            std::cout << YELLOW "ERROR - Could not open \"" << configuration->output_path << "\"" NOCOLOR << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream & output = configuration->output_path.empty() ? std::cout : output_file;
+    qpragma::shor::write_csv_header(output);
+
+    // Execute campaign
+    for (uint64_t size = configuration->min_size; size <= configuration->max_size; ++size) {
+        std::cerr << CYAN "Campaign for a register of " << size << " qubits" NOCOLOR << std::endl;
+        auto statistics = run_campaign(size, *configuration, std::make_integer_sequence<uint64_t, max_size - min_size + 1UL>());
+
+        for (const auto & item: statistics) {
+            qpragma::shor::write_csv(output, item);
+        }
+
+        if (not output.flush()) {
+            std::cout << YELLOW "ERROR - Could not write the statistics" NOCOLOR << std::endl;
+            return 1;
+        }
+    }
+
+    std::cerr << GREEN "Campaign done" NOCOLOR << std::endl;
+}
@@ -0,0 +1,287 @@
+#include "qpragma/shor/post_processing.h"
+
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include "qpragma/shor/fraction.h"
+#include "qpragma/shor/continued_fraction.h"
+
+
+/**
+ * Internal functions
+ */
+
+// Small bases used to split the cofactors once an order is known
+constexpr std::array<uint64_t, 6UL> small_bases = { 2UL, 3UL, 5UL, 7UL, 11UL, 13UL };
+
+
+// Find the square roots of 1 of the sequence x^s, x^(2s), ..., x^(2^t s) = x^r
+// (where r = 2^t s and s is odd) and refine the factors using these roots
+// (base^order is expected to be equal to 1 modulo factor)
+//
+// Returns true if a root different from ±1 has been found
+inline bool split_factor(std::vector<uint64_t> & factors, uint64_t base, uint64_t order, uint64_t factor) {
+    uint64_t odd_part = order;
+
+    while (odd_part % 2UL == 0UL) {
+        odd_part /= 2UL;
+    }
+
+    uint64_t value = qpragma::shor::pow_mod(base, odd_part, factor);
+
+    for (; odd_part < order; odd_part *= 2UL) {
+        // Only trivial square roots of 1 remain
+        if (value == 1UL or value == factor - 1UL) {
+            return false;
+        }
+
+        uint64_t square = qpragma::shor::mul_mod(value, value, factor);
+
+        if (square == 1UL) {
+            // "value" is a non-trivial square root of 1: both "value - 1" and "value + 1"
+            // share a non-trivial divisor with factor
+            qpragma::shor::refine_factors(factors, std::gcd(value - 1UL, factor));
+            qpragma::shor::refine_factors(factors, std::gcd(value + 1UL, factor));
+            return true;
+        }
+
+        value = square;
+    }
+
+    return false;
+}
+
+
+/**
+ * Post-processing implementation
+ */
+
+// Refine factors
+void qpragma::shor::refine_factors(std::vector<uint64_t> & factors, uint64_t divisor) {
+    std::vector<uint64_t> result;
+    result.reserve(factors.size() + 1UL);
+
+    for (uint64_t factor: factors) {
+        uint64_t common = std::gcd(factor, divisor);
+
+        if (common != 1UL and common != factor) {
+            result.push_back(common);
+            result.push_back(factor / common);
+        }
+
+        else {
+            result.push_back(factor);
+        }
+    }
+
+    factors = std::move(result);
+}
+
+
+// Split N using an order
+std::vector<uint64_t> qpragma::shor::split_with_order(uint64_t base, uint64_t order, uint64_t N_value, const deadline & limit) {
+    std::vector<uint64_t> factors = { N_value };
+
+    // An odd order gives only trivial square roots of 1
+    if (order == 0UL or order % 2UL == 1UL) {
+        return factors;
+    }
+
+    // Try to split each factor until no more progress is made. Once N is split, the order of
+    // the base modulo each cofactor divides the order: the same order is reused
+    std::vector<uint64_t> candidates = { base };
+    candidates.insert(candidates.end(), small_bases.begin(), small_bases.end());
+
+    bool progress = true;
+
+    while (progress and not limit.expired()) {
+        progress = false;
+
+        for (uint64_t factor: std::vector<uint64_t>(factors)) {
+            if (factor < 4UL) {
+                continue;
+            }
+
+            // Try the base first, then a few small bases whose order also divides "order"
+            bool split = false;
+
+            for (auto iterator = candidates.begin(); not split and iterator != candidates.end(); ++iterator) {
+                if (std::gcd(*iterator, factor) == 1UL and pow_mod(*iterator, order, factor) == 1UL) {
+                    split = split_factor(factors, *iterator % factor, order, factor);
+                }
+            }
+
+            progress = progress or split;
+        }
+    }
+
+    std::ranges::sort(factors);
+    return factors;
+}
+
+
+// Post-process an order
+qpragma::shor::attempt_result qpragma::shor::process_order(
+    uint64_t base, uint64_t order, uint64_t N_value, const deadline & limit
+) {
+    attempt_result result;
+    result.order = order;
+
+    // The search of the order may have been stopped by the deadline
+    if (order == 0UL) {
+        result.outcome = attempt_outcome::no_candidate;
+        result.interrupted = limit.expired();
+        return result;
+    }
+
+    if (order % 2UL == 1UL) {
+        result.outcome = attempt_outcome::odd_order;
+        return result;
+    }
+
+    // Extract every divisor
+    result.factors = split_with_order(base, order, N_value, limit);
+    result.outcome = result.factors.size() > 1UL ? attempt_outcome::success : attempt_outcome::trivial_split;
+    result.interrupted = result.outcome == attempt_outcome::trivial_split and limit.expired();
+    return result;
+}
+
+
+// Post-process a measurement
+qpragma::shor::attempt_result qpragma::shor::post_process(
+    uint64_t measurement, uint64_t nb_bits, uint64_t base, uint64_t N_value, const deadline & limit
+) {
+    // Base not coprime with N: a divisor is found classically
+    if (auto gcd = std::gcd(base, N_value); gcd != 1UL) {
+        attempt_result result;
+        result.outcome = attempt_outcome::classical_gcd;
+        result.factors = { N_value };
+        refine_factors(result.factors, gcd);
+        return result;
+    }
+
+    // Find the order using the continued fraction algorithm
+    if (nb_bits > max_measured_bits) {
+        throw std::out_of_range("Could not post-process the measurement - more than 63 bits");
+    }
+
+    fraction frac(measurement, 1UL << nb_bits);
+    return process_order(base, find_candidate(frac, base, N_value, limit), N_value, limit);  // If no candidate, 0UL is used
+}
+
+
+/**
+ * Prime factors estimation
+ */
+
+uint64_t qpragma::shor::estimate_prime_factors(uint64_t N_value, uint64_t bound) {
+    uint64_t nb_prime_factors = 0UL;
+
+    for (uint64_t divisor = 2UL; divisor < bound and divisor <= N_value / divisor; ++divisor) {
+        if (N_value % divisor != 0UL) {
+            continue;
+        }
+
+        ++nb_prime_factors;
+
+        while (N_value % divisor == 0UL) {
+            N_value /= divisor;
+        }
+    }
+
+    if (N_value > 1UL) {
+        ++nb_prime_factors;
+    }
+
+    return std::max(nb_prime_factors, 2UL);
+}
+
+
+/**
+ * Attempt budget implementation
+ */
+
+// Prior probability of finding the order from a measurement and weight of this prior
+// (expressed in number of attempts)
+constexpr double order_prior = 0.4;
+constexpr double prior_weight = 2.;
+
+
+// Constructor
+qpragma::shor::attempt_budget::attempt_budget(double failure_probability, uint64_t nb_prime_factors, uint64_t max_attempt)
+    : _failure_probability(failure_probability), _nb_prime_factors(std::max(nb_prime_factors, 2UL)), _max_attempt(max_attempt) {}
+
+
+// Record the outcome of an attempt
+void qpragma::shor::attempt_budget::record(attempt_outcome outcome) {
+    ++_nb_attempts;
+
+    switch (outcome) {
+    case attempt_outcome::classical_gcd:
+        return;
+    case attempt_outcome::no_candidate:
+        ++_nb_measured;
+        return;
+    case attempt_outcome::odd_order:
+    case attempt_outcome::trivial_split:
+        ++_nb_measured;
+        ++_nb_orders;
+        return;
+    case attempt_outcome::success:
+        ++_nb_measured;
+        ++_nb_orders;
+        ++_nb_splits;
+        return;
+    }
+}
+
+
+// Probability of finding the order
+double qpragma::shor::attempt_budget::order_probability() const {
+    return (static_cast<double>(_nb_orders) + prior_weight * order_prior)
+         / (static_cast<double>(_nb_measured) + prior_weight);
+}
+
+
+// Probability of splitting N once the order is found
+double qpragma::shor::attempt_budget::split_probability() const {
+    double prior = 1. - std::pow(2., 1. - static_cast<double>(_nb_prime_factors));
+    return (static_cast<double>(_nb_splits) + prior_weight * prior)
+         / (static_cast<double>(_nb_orders) + prior_weight);
+}
+
+
+// Probability of success of an attempt
+double qpragma::shor::attempt_budget::success_probability() const {
+    return order_probability() * split_probability();
+}
+
+
+// Number of attempts already performed
+uint64_t qpragma::shor::attempt_budget::attempts() const {
+    return _nb_attempts;
+}
+
+
+// Total number of attempts (performed attempts included)
+uint64_t qpragma::shor::attempt_budget::total() const {
+    double probability = std::clamp(success_probability(), 1e-6, 1. - 1e-6);
+    double needed = std::ceil(std::log(_failure_probability) / std::log(1. - probability));
+
+    return std::clamp(static_cast<uint64_t>(needed), 1UL, _max_attempt);
+}
+
+
+// Maximum number of attempts
+uint64_t qpragma::shor::attempt_budget::maximum() const {
+    return _max_attempt;
+}
+
+
+// Checks if the budget is exhausted
+bool qpragma::shor::attempt_budget::exhausted() const {
+    return _nb_attempts >= total();
+}
@@ -0,0 +1,143 @@
+// Include C++ stdlib (and boost)
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <optional>
+#include <iostream>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <boost/program_options/options_description.hpp>
+
+// Include Q-Pragma shor (the quantum part is not needed)
+#include "qpragma/shor/trace.h"
+
+#define GREEN   "\x1B[32m"
+#define YELLOW  "\x1B[33m"
+#define NOCOLOR "\x1B[0m"
+
+// Use Boost
+using boost::program_options::options_description;
+using boost::program_options::parse_command_line;
+using boost::program_options::variables_map;
+using boost::program_options::bool_switch;
+using boost::program_options::value;
+
+// Use Q-Pragma
+using qpragma::shor::trace_entry;
+using qpragma::shor::trace_reader;
+using qpragma::shor::attempt_outcome;
+
+
+// Useful classes
+struct Configuration {
+    std::string trace_path;
+    uint64_t repeat = 1UL;
+};
+
+
+/**
+ * Parse command line arguments
+ * This function is based on boost/program_options
+ */
+std::optional<Configuration> parse_arguments(int argc, char ** argv) {
+    // List all options
+    options_description options("Replay the classical part of a trace recorded by qpragma-shor");
+    options.add_options()
+        ("help,h", bool_switch()->default_value(false), "Display help")
+        ("trace,t", value<std::string>()->default_value(""), "Trace to replay (file path)")
+        ("repeat,n", value<uint64_t>()->default_value(1UL), "Number of times the trace is replayed (benchmark, at least 1)")
+        ;
+
+    // Parse arguments
+    variables_map parsed_arguments;
+    store(parse_command_line(argc, argv, options), parsed_arguments);
+
+    // Create configuration
+    if (parsed_arguments["help"].as<bool>() or parsed_arguments["trace"].as<std::string>().empty()) {
+        std::cout << options;
+        return std::nullopt;
+    }
+
+    // The trace is replayed at least once (outcomes are compared during the first replay)
+    if (parsed_arguments["repeat"].as<uint64_t>() == 0UL) {
+        std::cout << YELLOW "ERROR - The trace must be replayed at least once (--repeat 0)" NOCOLOR << std::endl;
+        return std::nullopt;
+    }
+
+    return Configuration {
+        .trace_path = parsed_arguments["trace"].as<std::string>(),
+        .repeat = parsed_arguments["repeat"].as<uint64_t>()
+    };
+}
+
+
+/**
+ * Main function.
+ * Replay the post-processing of each attempt and compare the outcome with the
+ * recorded one
+ */
+int main(int argc, char ** argv) {
+    // Parse arguments
+    auto configuration = parse_arguments(argc, argv);
+
+    if (not configuration) {
+        // No arguments
+        return 1;
+    }
+
+    // Load trace
+    std::vector<trace_entry> entries;
+    trace_reader reader(configuration->trace_path);
+
+    while (auto entry = reader.next()) {
+        entries.push_back(*entry);
+    }
+
+    // Replay trace
+    const std::array<std::string, 5UL> outcome_names = { "success", "classical gcd", "no candidate", "odd order", "trivial split" };
+    std::array<uint64_t, 5UL> nb_outcomes {};
+    uint64_t nb_mismatches = 0UL;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t iteration = 0UL; iteration < configuration->repeat; ++iteration) {
+        for (const auto & entry: entries) {
+            auto result = qpragma::shor::replay(entry);
+
+            if (iteration == 0UL) {
+                ++nb_outcomes[static_cast<uint8_t>(result.outcome)];
+
+                if (result.outcome != entry.outcome) {
+                    ++nb_mismatches;
+                    std::cout << YELLOW "Mismatch: N = " << entry.N_value << ", base = " << entry.base
+                              << ", measurement = " << entry.measurement << " (" << entry.nb_bits << " bits): recorded "
+                              << outcome_names[static_cast<uint8_t>(entry.outcome)] << ", replayed "
+                              << outcome_names[static_cast<uint8_t>(result.outcome)] << NOCOLOR << std::endl;
+                }
+            }
+        }
+    }
+
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Display summary
+    std::cout << "================ SHOR REPLAY ===============" << std::endl;
+    std::cout << "Attempts: " << entries.size() << std::endl;
+
+    for (uint64_t idx = 0UL; idx < outcome_names.size(); ++idx) {
+        std::cout << " > " << outcome_names[idx] << ": " << nb_outcomes[idx] << std::endl;
+    }
+
+    if (not entries.empty()) {
+        std::cout << "Post-processing time: "
+                  << elapsed.count() / static_cast<double>(entries.size() * configuration->repeat) << " us per attempt" << std::endl;
+    }
+
+    if (nb_mismatches != 0UL) {
+        std::cout << YELLOW "ERROR - " << nb_mismatches << " outcome(s) differ from the trace" NOCOLOR << std::endl;
+        return 2;
+    }
+
+    std::cout << GREEN "All outcomes match the trace" NOCOLOR << std::endl;
+}
@@ -0,0 +1,94 @@
+#include "qpragma/shor/resources.h"
+
+#include <vector>
+#include <complex>
+#include <iomanip>
+#include <stdexcept>
+
+#include "qpragma/shor/post_processing.h"
+#include "qpragma/shor/squaring_chain.h"
+
+
+// Estimate resources
+qpragma::shor::resource_estimate qpragma::shor::estimate_resources(
+    uint64_t size, uint64_t N_value, const multiplier_cost & cost, uint64_t base
+) {
+    // Ensure N can be stored in the quantum register
+    if (size >= 64UL or N_value >= (1UL << size)) {
+        throw std::out_of_range("Could not estimate resources - N does not fit in the quantum register");
+    }
+
+    resource_estimate estimate;
+
+    // Registers: control qubit, quantum register and ancillas of the multiplier
+    estimate.qubits = 1UL + size + cost.ancillas;
+
+    // Without base, no multiplication can be elided
+    std::vector<chain_step> chain(2UL * size);
+
+    if (base == 0UL) {
+        for (uint64_t idx = 0UL; idx < chain.size(); ++idx) {
+            chain[idx] = chain_step { .constant = 0UL, .identity = false, .first_occurrence = idx };
+        }
+    }
+
+    else {
+        chain = squaring_chain(base, 2UL * size, N_value);
+    }
+
+    // Walk the phase estimation like "measure_phase": circuits are synthesized using the same
+    // plan, each step using the control qubit applies "H, ctrl(U), PH, H" and a measurement.
+    // Measurements are unknown: every step following a multiplication may have measured 1
+    auto circuits = plan_circuits(chain);
+    uint64_t measurement = 0UL;
+
+    estimate.synthesized_circuits = circuits.constants.size();
+
+    for (uint64_t idx = 0UL; idx < chain.size(); ++idx) {
+        if (not uses_control(chain[idx], measurement)) {
+            continue;
+        }
+
+        estimate.hadamard_gates += 2UL;
+        estimate.phase_gates += 1UL;
+        estimate.measurements += 1UL;
+        estimate.depth += 4UL;
+
+        if (not chain[idx].identity) {
+            estimate.controlled_multiplications += 1UL;
+            estimate.depth += cost.depth;
+            measurement |= 1UL << idx;
+        }
+    }
+
+    estimate.gates = estimate.hadamard_gates + estimate.phase_gates + estimate.controlled_multiplications * cost.gates;
+
+    // The emulator stores a state vector of 2^qubits amplitudes
+    estimate.memory_bytes = estimate.qubits < 60UL ?
+        (1UL << estimate.qubits) * sizeof(std::complex<double>) : UINT64_MAX;
+
+    // Attempts (the budget of "find_factors")
+    attempt_budget budget(1e-3, estimate_prime_factors(N_value));
+    estimate.expected_attempts = 1. / budget.success_probability();
+    estimate.max_attempts = budget.total();
+
+    return estimate;
+}
+
+
+// Display a resource estimate
+std::ostream & operator<<(std::ostream & stream, const qpragma::shor::resource_estimate & estimate) {
+    stream << "Qubits: " << estimate.qubits << "\n"
+           << "Controlled multiplications: " << estimate.controlled_multiplications
+           << " (" << estimate.synthesized_circuits << " synthesized)\n"
+           << "Hadamard gates: " << estimate.hadamard_gates << "\n"
+           << "Phase gates: " << estimate.phase_gates << "\n"
+           << "Measurements: " << estimate.measurements << "\n"
+           << "Gates (total): " << estimate.gates << "\n"
+           << "Circuit depth: " << estimate.depth << "\n"
+           << "Emulator memory: " << estimate.memory_bytes << " bytes\n"
+           << "Expected attempts: " << std::fixed << std::setprecision(1) << estimate.expected_attempts
+           << " (at most " << estimate.max_attempts << ")";
+
+    return stream;
+}
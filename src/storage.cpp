@@ -0,0 +1,226 @@
+#include "qpragma/shor/storage.h"
+
+#include <new>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+
+/**
+ * Internal functions
+ */
+
+// Alignment of the amplitudes stored in memory
+constexpr std::align_val_t cache_line = std::align_val_t(64UL);
+
+
+// Size of a page
+inline std::size_t page_size() {
+    static const std::size_t result = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return result;
+}
+
+
+/**
+ * Amplitude storage
+ */
+
+// Constructor
+qpragma::shor::amplitude_storage::amplitude_storage(uint64_t size, uint64_t block_size):
+    _size(size), _block_size(std::clamp(block_size, uint64_t(1UL), std::max(size, uint64_t(1UL))))
+{}
+
+
+// Getters
+uint64_t qpragma::shor::amplitude_storage::size() const {
+    return _size;
+}
+
+
+uint64_t qpragma::shor::amplitude_storage::block_size() const {
+    return _block_size;
+}
+
+
+qpragma::shor::amplitude * qpragma::shor::amplitude_storage::data() {
+    return _data;
+}
+
+
+const qpragma::shor::amplitude * qpragma::shor::amplitude_storage::data() const {
+    return _data;
+}
+
+
+// Amplitudes are resident by default
+bool qpragma::shor::amplitude_storage::out_of_core() const {
+    return false;
+}
+
+
+void qpragma::shor::amplitude_storage::prefetch(uint64_t, uint64_t) const {}
+
+
+void qpragma::shor::amplitude_storage::advise(uint64_t, uint64_t) const {}
+
+
+/**
+ * Memory storage
+ */
+
+// Constructor: large allocations are mapped lazily, pages are touched by the first writer
+qpragma::shor::memory_storage::memory_storage(uint64_t size, bool initialize):
+    amplitude_storage(size, size),
+    _amplitudes(static_cast<amplitude *>(::operator new(std::max(size, uint64_t(1UL)) * sizeof(amplitude), cache_line)))
+{
+    _data = _amplitudes.get();
+
+    if (initialize) {
+        std::fill(_data, _data + _size, amplitude(0., 0.));
+    }
+}
+
+
+void qpragma::shor::memory_storage::deleter::operator()(amplitude * data) const {
+    ::operator delete(data, cache_line);
+}
+
+
+std::unique_ptr<qpragma::shor::amplitude_storage> qpragma::shor::memory_storage::clone(bool copy) const {
+    auto result = std::make_unique<memory_storage>(_size, not copy);
+
+    if (copy) {
+        std::copy(_data, _data + _size, result->_data);
+    }
+
+    return result;
+}
+
+
+std::unique_ptr<qpragma::shor::amplitude_storage> qpragma::shor::memory_storage::allocate() const {
+    return std::make_unique<memory_storage>(_size, false);
+}
+
+
+/**
+ * Mapped storage
+ */
+
+// Constructor: create, map and unlink a sparse file
+qpragma::shor::mapped_storage::mapped_storage(uint64_t size, const std::string & directory, uint64_t block_size):
+    amplitude_storage(size, block_size),
+    _directory(directory.empty() ? std::filesystem::temp_directory_path().string() : directory),
+    _mapped_size(std::max<std::size_t>(size * sizeof(amplitude), 1UL))
+{
+    std::string path = (std::filesystem::path(_directory) / "qpragma-shor-XXXXXX").string();
+    int file_descriptor = mkstemp(path.data());
+
+    if (file_descriptor < 0) {
+        throw std::runtime_error("Could not create a mapped statevector in \"" + _directory + "\"");
+    }
+
+    unlink(path.c_str());
+
+    if (ftruncate(file_descriptor, static_cast<off_t>(_mapped_size)) != 0) {
+        close(file_descriptor);
+        throw std::runtime_error("Could not allocate a mapped statevector in \"" + _directory + "\"");
+    }
+
+    // The mapping keeps the file alive
+    void * mapping = mmap(nullptr, _mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor);
+
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Could not map a statevector in \"" + _directory + "\"");
+    }
+
+    _data = static_cast<amplitude *>(mapping);
+}
+
+
+// Destructor
+qpragma::shor::mapped_storage::~mapped_storage() {
+    munmap(_data, _mapped_size);
+}
+
+
+// Prefetch: ask the kernel to read the pages ahead, then fault them in
+bool qpragma::shor::mapped_storage::out_of_core() const {
+    return true;
+}
+
+
+void qpragma::shor::mapped_storage::prefetch(uint64_t first, uint64_t count) const {
+    if (first >= _size or count == 0UL) {
+        return;
+    }
+
+    count = std::min(count, _size - first);
+    advise(first, count);
+
+    const uint64_t stride = std::max<uint64_t>(page_size() / sizeof(amplitude), 1UL);
+
+    for (uint64_t idx = first; idx < first + count; idx += stride) {
+        touch(_data[idx]);
+    }
+}
+
+
+// Advise: the kernel reads the pages ahead, they are not faulted in
+void qpragma::shor::mapped_storage::advise(uint64_t first, uint64_t count) const {
+    if (first >= _size or count == 0UL) {
+        return;
+    }
+
+    count = std::min(count, _size - first);
+
+    const std::size_t page = page_size();
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(_data + first) & ~(page - 1UL);
+    const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(_data + first + count);
+    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_WILLNEED);
+}
+
+
+std::unique_ptr<qpragma::shor::amplitude_storage> qpragma::shor::mapped_storage::clone(bool copy) const {
+    auto result = std::make_unique<mapped_storage>(_size, _directory, _block_size);
+
+    if (copy) {
+        // Copy block per block, blocks of zeros are skipped to keep the file sparse
+        for (uint64_t first = 0UL; first < _size; first += _block_size) {
+            uint64_t count = std::min(_block_size, _size - first);
+            const amplitude * begin = _data + first;
+
+            if (std::any_of(begin, begin + count, [](const amplitude & value) { return value != amplitude(0., 0.); })) {
+                std::memcpy(static_cast<void *>(result->_data + first), begin, count * sizeof(amplitude));
+            }
+        }
+    }
+
+    return result;
+}
+
+
+// Holes of the file are read as zeros
+std::unique_ptr<qpragma::shor::amplitude_storage> qpragma::shor::mapped_storage::allocate() const {
+    return std::make_unique<mapped_storage>(_size, _directory, _block_size);
+}
+
+
+/**
+ * Factory
+ */
+
+std::unique_ptr<qpragma::shor::amplitude_storage> qpragma::shor::make_storage(
+    uint64_t size, const storage_options & options, bool initialize
+) {
+    if (options.backend == storage_backend::mapped) {
+        return std::make_unique<mapped_storage>(size, options.directory, options.block_size);
+    }
+
+    return std::make_unique<memory_storage>(size, initialize);
+}
@@ -0,0 +1,151 @@
+#include "qpragma/shor/trace.h"
+
+#include <stdexcept>
+#include <algorithm>
+
+
+/**
+ * Internal functions
+ */
+
+// File format
+constexpr char trace_magic[8] = { 'Q', 'P', 'S', 'H', 'O', 'R', 'T', '1' };
+
+
+// Write an integer using LEB128 encoding
+inline void write_integer(std::ostream & stream, uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7fUL;
+        value >>= 7UL;
+
+        if (value != 0UL) {
+            byte |= 0x80U;
+        }
+
+        stream.put(static_cast<char>(byte));
+    } while (value != 0UL);
+}
+
+
+// Read an integer encoded using LEB128 encoding
+// Returns std::nullopt if the end of the stream is reached
+inline std::optional<uint64_t> read_integer(std::istream & stream) {
+    uint64_t value = 0UL;
+
+    for (uint64_t shift = 0UL; shift < 64UL; shift += 7UL) {
+        int byte = stream.get();
+
+        if (byte == std::char_traits<char>::eof()) {
+            return std::nullopt;
+        }
+
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+
+    throw std::runtime_error("Invalid trace - integer too large");
+}
+
+
+/**
+ * Trace writer implementation
+ */
+
+// Constructor
+qpragma::shor::trace_writer::trace_writer(const std::string & path): _stream(path, std::ios::binary | std::ios::trunc) {
+    if (not _stream) {
+        throw std::runtime_error("Could not open trace \"" + path + "\"");
+    }
+
+    _stream.write(trace_magic, sizeof(trace_magic));
+}
+
+
+// Write an entry
+void qpragma::shor::trace_writer::write(const trace_entry & entry) {
+    write_integer(_stream, entry.N_value);
+    write_integer(_stream, entry.size);
+    write_integer(_stream, entry.nb_bits);
+    write_integer(_stream, entry.base);
+    write_integer(_stream, entry.measurement);
+    _stream.put(static_cast<char>(entry.outcome));
+}
+
+
+// Flush the trace
+void qpragma::shor::trace_writer::flush() {
+    _stream.flush();
+}
+
+
+/**
+ * Trace reader implementation
+ */
+
+// Constructor
+qpragma::shor::trace_reader::trace_reader(const std::string & path): _stream(path, std::ios::binary) {
+    char magic[sizeof(trace_magic)];
+
+    if (not _stream.read(magic, sizeof(magic)) or not std::equal(magic, magic + sizeof(magic), trace_magic)) {
+        throw std::runtime_error("Invalid trace \"" + path + "\"");
+    }
+}
+
+
+// Read next entry
+std::optional<qpragma::shor::trace_entry> qpragma::shor::trace_reader::next() {
+    trace_entry entry;
+
+    // The end of the trace is expected only before the first field
+    auto N_value = read_integer(_stream);
+
+    if (not N_value) {
+        return std::nullopt;
+    }
+
+    entry.N_value = *N_value;
+
+    for (uint64_t * field: { &entry.size, &entry.nb_bits, &entry.base, &entry.measurement }) {
+        auto value = read_integer(_stream);
+
+        if (not value) {
+            throw std::runtime_error("Invalid trace - truncated entry");
+        }
+
+        *field = *value;
+    }
+
+    // Fields are used by the post-processing: they must describe a valid measurement
+    if (entry.N_value < 2UL) {
+        throw std::runtime_error("Invalid trace - invalid number");
+    }
+
+    if (entry.base >= entry.N_value) {
+        throw std::runtime_error("Invalid trace - invalid base");
+    }
+
+    if (entry.nb_bits > max_measured_bits or entry.measurement >= (1UL << entry.nb_bits)) {
+        throw std::runtime_error("Invalid trace - invalid measurement");
+    }
+
+    int outcome = _stream.get();
+
+    if (outcome == std::char_traits<char>::eof() or outcome > static_cast<int>(attempt_outcome::trivial_split)) {
+        throw std::runtime_error("Invalid trace - invalid outcome");
+    }
+
+    entry.outcome = static_cast<attempt_outcome>(outcome);
+    return entry;
+}
+
+
+/**
+ * Replay
+ */
+
+qpragma::shor::attempt_result qpragma::shor::replay(const trace_entry & entry) {
+    return post_process(entry.measurement, entry.nb_bits, entry.base, entry.N_value);
+}
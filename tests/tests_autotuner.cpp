@@ -0,0 +1,151 @@
+/**
+ * This test file ensure that the cost model and the tuner defined in
+ * "qpragma/shor/autotuner.h" work as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <string>
+#include <iterator>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/autotuner.h"
+
+using qpragma::shor::cost_model;
+using qpragma::shor::calibration_options;
+using qpragma::shor::calibrate;
+using qpragma::shor::load_or_calibrate;
+using qpragma::shor::tune;
+using qpragma::shor::storage_backend;
+using qpragma::shor::emulator_engine;
+
+
+// Model of a machine having 4 hardware threads
+cost_model four_threads() {
+    cost_model model;
+    model.classical_ns = 50.;
+    model.engine_ns = { { 1UL, 8. }, { 2UL, 4.5 }, { 4UL, 2.5 } };
+    model.shot_factor = 0.5;
+    model.mapped_factor = 3.;
+    model.memory_bytes = 1UL << 30UL;
+
+    return model;
+}
+
+
+// Unique temporary directory, removed at the end of a test (tests may run concurrently)
+struct temporary_directory {
+    std::filesystem::path path;
+
+    temporary_directory() {
+        auto pattern = (std::filesystem::temp_directory_path() / "qpragma-shor-tests-XXXXXX").string();
+        if (mkdtemp(pattern.data()) == nullptr) {
+            throw std::runtime_error("Cannot create a temporary directory");
+        }
+
+        path = pattern;
+    }
+
+    ~temporary_directory() {
+        std::filesystem::remove_all(path);
+    }
+};
+
+
+/**
+ * Test cost model persistence
+ */
+
+TEST(CostModel, SaveLoad) {
+    temporary_directory directory;
+    auto path = (directory.path / "cost-model.txt").string();
+    auto model = four_threads();
+    model.classical_ns = 1. / 3.;
+    model.save(path);
+    model.save(path);
+
+    // The model replaces the previous one, no temporary file is left
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory.path), std::filesystem::directory_iterator()), 1L);
+
+    auto loaded = cost_model::load(path);
+    EXPECT_EQ(loaded.classical_ns, model.classical_ns);
+    EXPECT_EQ(loaded.engine_ns, model.engine_ns);
+    EXPECT_EQ(loaded.shot_factor, model.shot_factor);
+    EXPECT_EQ(loaded.mapped_factor, model.mapped_factor);
+    EXPECT_EQ(loaded.memory_bytes, model.memory_bytes);
+
+    std::ofstream(path) << "not a cost model\n";
+    EXPECT_THROW(cost_model::load(path), std::runtime_error);
+}
+
+TEST(CostModel, Calibration) {
+    // The calibrated model is stored, and loaded by the next calls
+    temporary_directory directory;
+    auto path = (directory.path / "calibrated-model.txt").string();
+
+    auto model = load_or_calibrate(path, calibration_options { .size = 8UL, .repetitions = 1UL, .max_threads = 2UL });
+    ASSERT_TRUE(std::filesystem::exists(path));
+
+    EXPECT_GT(model.classical_ns, 0.);
+    EXPECT_EQ(model.engine_ns.size(), 2UL);
+    EXPECT_GT(model.engine_ns.at(1UL), 0.);
+    EXPECT_GE(model.mapped_factor, 1.);
+    EXPECT_GT(model.memory_bytes, 0UL);
+
+    EXPECT_EQ(load_or_calibrate(path).engine_ns, model.engine_ns);
+}
+
+
+/**
+ * Test tuning
+ */
+
+TEST(Tuning, ClassicalOrQuantum) {
+    auto model = four_threads();
+
+    // Small numbers: the classical order finder is faster than the emulation of 24 qubits
+    auto small = tune(model, 24UL, 221UL);
+    EXPECT_TRUE(small.classical);
+
+    // Unless classical solutions are ignored
+    auto quantum = tune(model, 24UL, 221UL, true);
+    EXPECT_FALSE(quantum.classical);
+    EXPECT_GT(quantum.expected_ms, small.expected_ms);
+
+    // Large numbers of small registers are cheaper to emulate
+    model.classical_ns = 1e6;
+    EXPECT_FALSE(tune(model, 20UL, (1UL << 20UL) - 3UL).classical);
+}
+
+TEST(Tuning, Parallelism) {
+    auto model = four_threads();
+    model.classical_ns = 1e9;
+
+    // The fastest engine is chosen
+    auto result = tune(model, 20UL, 1040399UL);
+    EXPECT_EQ(result.engine.engine, emulator_engine::parallel);
+    EXPECT_EQ(result.engine.nb_threads, 4UL);
+    EXPECT_EQ(result.storage.backend, storage_backend::memory);
+
+    // Cheap shots (shared prefixes) are worth sampling, expensive shots are not. The shots of a
+    // base share its split probability: their gain is bounded
+    model.shot_factor = 0.05;
+    EXPECT_EQ(tune(model, 20UL, 1040399UL).shots, 4UL);
+
+    model.shot_factor = 0.01;
+    EXPECT_GT(tune(model, 20UL, 1040399UL).shots, 4UL);
+
+    model.shot_factor = 1.;
+    EXPECT_EQ(tune(model, 20UL, 1040399UL).shots, 1UL);
+
+    // Registers larger than the memory are stored out-of-core
+    model.memory_bytes = 1UL << 20UL;
+    EXPECT_EQ(tune(model, 20UL, 1040399UL, false, "/tmp").storage.backend, storage_backend::mapped);
+
+    // Measurements of registers above 31 qubits do not fit in 63 bits
+    EXPECT_TRUE(tune(model, 32UL, (1UL << 32UL) - 5UL).classical);
+}
@@ -0,0 +1,118 @@
+/**
+ * This test file ensure that the base scheduler defined in
+ * "qpragma/shor/base_scheduler.h" works as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/base_scheduler.h"
+
+using qpragma::shor::random_stream;
+using qpragma::shor::jacobi_symbol;
+using qpragma::shor::base_scheduler;
+
+
+/**
+ * Test random streams
+ */
+
+TEST(RandomStream, Reproducible) {
+    random_stream first(1234UL, 21UL, 3UL);
+    random_stream second(1234UL, 21UL, 3UL);
+    random_stream other(1234UL, 21UL, 4UL);
+    bool different = false;
+
+    for (uint64_t idx = 0UL; idx < 16UL; ++idx) {
+        uint64_t value = first();
+        EXPECT_EQ(value, second());
+        different = different or value != other();
+    }
+
+    EXPECT_TRUE(different);
+}
+
+TEST(RandomStream, Uniform) {
+    random_stream stream(42UL, 35UL, 0UL);
+
+    for (uint64_t idx = 0UL; idx < 1000UL; ++idx) {
+        uint64_t value = stream.uniform(2UL, 33UL);
+        EXPECT_GE(value, 2UL);
+        EXPECT_LE(value, 33UL);
+    }
+}
+
+
+/**
+ * Test Jacobi symbol
+ */
+
+TEST(JacobiSymbol, KnownValues) {
+    EXPECT_EQ(jacobi_symbol(2UL, 15UL), 1);
+    EXPECT_EQ(jacobi_symbol(7UL, 15UL), -1);
+    EXPECT_EQ(jacobi_symbol(3UL, 15UL), 0);
+    EXPECT_EQ(jacobi_symbol(2UL, 21UL), -1);
+    EXPECT_EQ(jacobi_symbol(1001UL, 9907UL), -1);
+    EXPECT_EQ(jacobi_symbol(19UL, 45UL), 1);
+}
+
+
+/**
+ * Test base scheduler
+ */
+
+TEST(BaseScheduler, NoRepetition) {
+    // Bases of 35 are 2..33
+    base_scheduler scheduler(35UL);
+    std::set<uint64_t> bases;
+
+    while (auto base = scheduler.next()) {
+        EXPECT_TRUE(bases.insert(*base).second);
+        EXPECT_NE(*base, 1UL);
+        EXPECT_NE(*base, 34UL);
+    }
+
+    EXPECT_EQ(bases.size(), 32UL);
+    EXPECT_EQ(scheduler.scheduled(), 32UL);
+    EXPECT_FALSE(scheduler.next());
+}
+
+TEST(BaseScheduler, PerfectSquares) {
+    // 4 has order 2 modulo 15, and gcd(4 - 1, 15) * gcd(4 + 1, 15) = 3 * 5
+    base_scheduler scheduler(15UL);
+    EXPECT_TRUE(scheduler.is_eligible(4UL));
+    EXPECT_TRUE(scheduler.is_eligible(9UL));
+
+    std::set<uint64_t> bases;
+
+    while (auto base = scheduler.next()) {
+        bases.insert(*base);
+    }
+
+    EXPECT_TRUE(bases.contains(4UL));
+    EXPECT_TRUE(bases.contains(9UL));
+    EXPECT_EQ(bases.size(), 12UL);
+}
+
+TEST(BaseScheduler, PreferNonResidues) {
+    // First bases are quadratic non-residues: their order is even
+    base_scheduler scheduler(10403UL, 7UL);
+
+    for (uint64_t idx = 0UL; idx < 32UL; ++idx) {
+        auto base = scheduler.next();
+        ASSERT_TRUE(base);
+        EXPECT_EQ(jacobi_symbol(*base, 10403UL), -1);
+    }
+}
+
+TEST(BaseScheduler, Reproducible) {
+    base_scheduler first(10403UL, 99UL);
+    base_scheduler second(10403UL, 99UL);
+
+    for (uint64_t idx = 0UL; idx < 64UL; ++idx) {
+        EXPECT_EQ(first.next(), second.next());
+    }
+}
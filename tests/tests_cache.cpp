@@ -0,0 +1,137 @@
+/**
+ * This test file ensure that the persistent cache defined in "qpragma/shor/cache.h"
+ * works as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <filesystem>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/cache.h"
+
+using qpragma::shor::order_cache;
+
+
+/**
+ * Get a path to a new cache
+ */
+inline std::string cache_path(const std::string & name) {
+    auto path = std::filesystem::temp_directory_path() / ("qpragma-shor-" + name + ".cache");
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+
+/**
+ * Test class qpragma::shor::order_cache
+ */
+
+TEST(OrderCache, StoreAndFind) {
+    order_cache cache(cache_path("store"));
+
+    ASSERT_FALSE(cache.find_order(7UL, 15UL));
+    ASSERT_TRUE(cache.find_factors(15UL).empty());
+
+    cache.store_order(7UL, 15UL, 4UL);
+    cache.store_factors(15UL, { 5UL, 3UL });
+    cache.store_factors(15UL, { 3UL, 5UL });  // Already known - ignored
+
+    ASSERT_EQ(cache.find_order(7UL, 15UL), 4UL);
+    ASSERT_EQ(cache.find_factors(15UL), std::vector<uint64_t>({ 3UL, 5UL }));
+    ASSERT_EQ(cache.size(), 3UL);
+}
+
+
+TEST(OrderCache, SharedBetweenInstances) {
+    auto path = cache_path("shared");
+    order_cache writer(path);
+    order_cache reader(path, true);
+
+    writer.store_order(2UL, 21UL, 6UL);
+    ASSERT_EQ(reader.find_order(2UL, 21UL), 6UL);
+
+    // Read-only cache can not be modified
+    ASSERT_THROW(reader.store_order(4UL, 21UL, 3UL), std::runtime_error);
+
+    // Entries are persistent
+    order_cache reopened(path, true);
+    ASSERT_EQ(reopened.find_order(2UL, 21UL), 6UL);
+}
+
+
+TEST(OrderCache, PartialRecordIgnored) {
+    auto path = cache_path("partial");
+
+    {
+        order_cache cache(path);
+        cache.store_order(7UL, 15UL, 4UL);
+    }
+
+    // Simulate a crash during an append
+    {
+        std::ofstream stream(path, std::ios::binary | std::ios::app);
+        stream << "garbage";
+    }
+
+    order_cache cache(path);
+    ASSERT_EQ(cache.size(), 1UL);
+    ASSERT_EQ(cache.find_order(7UL, 15UL), 4UL);
+
+    // The partial record is skipped, the file never shrinks (other processes may map it)
+    auto size = std::filesystem::file_size(path);
+    cache.store_order(2UL, 15UL, 4UL);
+    ASSERT_GT(std::filesystem::file_size(path), size);
+
+    order_cache reopened(path, true);
+    ASSERT_EQ(reopened.size(), 2UL);
+    ASSERT_EQ(reopened.find_order(7UL, 15UL), 4UL);
+    ASSERT_EQ(reopened.find_order(2UL, 15UL), 4UL);
+}
+
+
+TEST(OrderCache, CorruptedRecordSkipped) {
+    auto path = cache_path("corrupted");
+
+    {
+        order_cache cache(path);
+        cache.store_order(7UL, 15UL, 4UL);
+        cache.store_order(2UL, 21UL, 6UL);
+        cache.store_order(2UL, 15UL, 4UL);
+    }
+
+    // Corrupt the first record (after the 16 bytes header)
+    {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(16);
+        stream << "garbage";
+    }
+
+    // Records following the corrupted one are still read, and kept by the next append
+    order_cache cache(path);
+    ASSERT_EQ(cache.size(), 2UL);
+    ASSERT_FALSE(cache.find_order(7UL, 15UL));
+    ASSERT_EQ(cache.find_order(2UL, 21UL), 6UL);
+
+    cache.store_order(7UL, 15UL, 4UL);
+
+    order_cache reopened(path, true);
+    ASSERT_EQ(reopened.size(), 3UL);
+    ASSERT_EQ(reopened.find_order(2UL, 15UL), 4UL);
+    ASSERT_EQ(reopened.find_order(7UL, 15UL), 4UL);
+}
+
+
+TEST(OrderCache, InvalidFile) {
+    auto path = cache_path("invalid");
+
+    {
+        std::ofstream stream(path, std::ios::binary);
+        stream << "not a cache file";
+    }
+
+    ASSERT_THROW(order_cache(path, true), std::runtime_error);
+}
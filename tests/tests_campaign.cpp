@@ -0,0 +1,92 @@
+/**
+ * This test file ensure that the campaign helpers defined in
+ * "qpragma/shor/campaign.h" work as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <string>
+#include <vector>
+#include <sstream>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/campaign.h"
+
+using qpragma::shor::semiprimes;
+using qpragma::shor::campaign_base;
+using qpragma::shor::campaign_statistics;
+using qpragma::shor::attempt_outcome;
+
+
+/**
+ * Test corpus generation
+ */
+
+TEST(Campaign, Semiprimes) {
+    // Products of two distinct odd primes (squares of primes are excluded)
+    EXPECT_EQ(semiprimes(4UL), std::vector<uint64_t>({ 15UL }));
+    EXPECT_EQ(semiprimes(5UL), std::vector<uint64_t>({ 15UL, 21UL }));
+    EXPECT_EQ(semiprimes(6UL), std::vector<uint64_t>({ 15UL, 21UL, 33UL, 35UL, 39UL, 51UL, 55UL, 57UL }));
+}
+
+TEST(Campaign, Bases) {
+    // Bases only depend on the seed, N and the index of the attempt
+    for (uint64_t attempt_idx = 0UL; attempt_idx < 100UL; ++attempt_idx) {
+        uint64_t base = campaign_base(7UL, 21UL, attempt_idx);
+
+        EXPECT_GE(base, 2UL);
+        EXPECT_LE(base, 20UL);
+        EXPECT_EQ(base, campaign_base(7UL, 21UL, attempt_idx));
+    }
+
+    // Attempts draw different bases
+    uint64_t nb_changes = 0UL;
+
+    for (uint64_t attempt_idx = 1UL; attempt_idx < 100UL; ++attempt_idx) {
+        nb_changes += campaign_base(7UL, 221UL, attempt_idx) != campaign_base(7UL, 221UL, attempt_idx - 1UL) ? 1UL : 0UL;
+    }
+
+    EXPECT_GT(nb_changes, 90UL);
+}
+
+
+/**
+ * Test statistics aggregation
+ */
+
+TEST(Campaign, Statistics) {
+    campaign_statistics first { .N_value = 21UL, .size = 5UL };
+    campaign_statistics second { .N_value = 21UL, .size = 5UL };
+
+    first.record(attempt_outcome::success, 2.);
+    first.record(attempt_outcome::classical_gcd, 1.);
+    second.record(attempt_outcome::odd_order, 3.);
+    second.record(attempt_outcome::success, 2.);
+
+    first += second;
+
+    EXPECT_EQ(first.attempts, 4UL);
+    EXPECT_EQ(first.count(attempt_outcome::success), 2UL);
+    EXPECT_EQ(first.count(attempt_outcome::odd_order), 1UL);
+    EXPECT_DOUBLE_EQ(first.success_probability(), 2. / 3.);  // Classical gcds are excluded
+    EXPECT_DOUBLE_EQ(first.time_per_attempt_ms(), 2.);
+
+    EXPECT_DOUBLE_EQ(campaign_statistics().success_probability(), 0.);
+    EXPECT_DOUBLE_EQ(campaign_statistics().time_per_attempt_ms(), 0.);
+}
+
+TEST(Campaign, Csv) {
+    campaign_statistics statistics { .N_value = 15UL, .size = 4UL };
+    statistics.record(attempt_outcome::success, 1.5);
+    statistics.record(attempt_outcome::trivial_split, 0.5);
+
+    std::ostringstream stream;
+    qpragma::shor::write_csv_header(stream);
+    qpragma::shor::write_csv(stream, statistics);
+
+    EXPECT_EQ(
+        stream.str(),
+        "N,size,attempts,success,classical_gcd,no_candidate,odd_order,trivial_split,success_probability,time_per_attempt_ms\n"
+        "15,4,2,1,0,0,0,1,0.5,1\n"
+    );
+}
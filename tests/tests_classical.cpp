@@ -0,0 +1,113 @@
+/**
+ * This test file ensure that the classical algorithms defined in
+ * "qpragma/shor/classical.h" work as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/classical.h"
+#include "qpragma/shor/continued_fraction.h"
+
+using qpragma::shor::pow_mod;
+using qpragma::shor::trial_division;
+using qpragma::shor::classical_order;
+using qpragma::shor::validate_order;
+using qpragma::shor::deadline;
+
+
+/**
+ * Test classical order finding
+ */
+
+TEST(ClassicalOrder, SmallNumbers) {
+    // Baby-step giant-step gives the same orders as a naive search
+    for (uint64_t N_value: { 15UL, 21UL, 35UL, 91UL, 221UL, 1007UL, 10403UL }) {
+        for (uint64_t base = 2UL; base < N_value; ++base) {
+            if (std::gcd(base, N_value) != 1UL) {
+                EXPECT_EQ(classical_order(base, N_value), 0UL);
+                continue;
+            }
+
+            uint64_t expected = 1UL;
+
+            for (uint64_t power = base; power != 1UL; power = (power * base) % N_value) {
+                ++expected;
+            }
+
+            ASSERT_EQ(classical_order(base, N_value), expected) << base << " modulo " << N_value;
+        }
+    }
+}
+
+TEST(ClassicalOrder, LargeOrder) {
+    // N = 2097143 * 2097133: orders larger than the table of baby steps are found by kangaroos
+    constexpr uint64_t N_value = 4397987791019UL;
+    uint64_t order = classical_order(2UL, N_value);
+    ASSERT_NE(order, 0UL);
+    EXPECT_EQ(pow_mod(2UL, order, N_value), 1UL);
+
+    // No proper divisor of the order is a multiple of the order
+    for (uint64_t rest = order; rest > 1UL;) {
+        uint64_t prime = trial_division(rest);
+        prime = prime == 0UL ? rest : prime;
+        EXPECT_NE(pow_mod(2UL, order / prime, N_value), 1UL) << prime;
+
+        while (rest % prime == 0UL) {
+            rest /= prime;
+        }
+    }
+}
+
+
+/**
+ * Test trial division
+ */
+
+TEST(TrialDivision, SmallestDivisor) {
+    EXPECT_EQ(trial_division(14UL), 2UL);
+    EXPECT_EQ(trial_division(15UL), 3UL);
+    EXPECT_EQ(trial_division(221UL), 13UL);
+    EXPECT_EQ(trial_division(1000003UL * 1000033UL), 1000003UL);
+}
+
+TEST(TrialDivision, Primes) {
+    EXPECT_EQ(trial_division(2UL), 0UL);
+    EXPECT_EQ(trial_division(13UL), 0UL);
+    EXPECT_EQ(trial_division(1000003UL), 0UL);
+}
+
+TEST(TrialDivision, Deadline) {
+    // The deadline expires before the divisor is found
+    EXPECT_EQ(trial_division(1000003UL * 1000033UL, deadline(std::chrono::milliseconds(0))), 0UL);
+    EXPECT_EQ(classical_order(2UL, 1000003UL * 1000033UL, deadline(std::chrono::milliseconds(0))), 0UL);
+}
+
+
+/**
+ * Test validation of the post-processing
+ */
+
+TEST(ValidateOrder, Multiples) {
+    EXPECT_NO_THROW(validate_order(2UL, 6UL, 21UL));
+    EXPECT_THROW(validate_order(2UL, 3UL, 21UL), std::logic_error);
+    EXPECT_THROW(validate_order(7UL, 6UL, 15UL), std::logic_error);
+    EXPECT_THROW(validate_order(2UL, 0UL, 21UL), std::logic_error);
+
+    // Multiples of the order are not minimal
+    EXPECT_THROW(validate_order(2UL, 12UL, 21UL), std::logic_error);
+    EXPECT_THROW(validate_order(2UL, 18UL, 21UL), std::logic_error);
+}
+
+TEST(ValidateOrder, ClassicalOrders) {
+    // Orders computed by the classical order finder are valid
+    for (uint64_t N_value: { 21UL, 221UL, 10403UL, 65519UL * 65521UL }) {
+        for (uint64_t x_value: { 2UL, 5UL, 11UL }) {
+            EXPECT_NO_THROW(validate_order(x_value, classical_order(x_value, N_value), N_value)) << x_value << " mod " << N_value;
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/**
+ * This test file ensure that the tables defined in "qpragma/shor/compiled_modulus.h"
+ * work as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <vector>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/compiled_modulus.h"
+#include "qpragma/shor/squaring_chain.h"
+
+using qpragma::shor::compiled_modulus;
+using qpragma::shor::squaring_chain;
+using qpragma::shor::attempt_outcome;
+
+
+/**
+ * Test tables computed at compile time
+ */
+
+TEST(CompiledModulus, Tables) {
+    using tables = compiled_modulus<4UL, 15UL>;
+
+    static_assert(tables::gcds[3] == 3UL and tables::gcds[7] == 1UL);
+    static_assert(tables::orders[2] == 4UL and tables::orders[4] == 2UL and tables::orders[14] == 2UL);
+    static_assert(tables::divisors[2] == 3UL and tables::divisors[11] == 5UL and tables::divisors[14] == 0UL);
+    static_assert(tables::chains[7][7].constant == 7UL and tables::chains[7][0].identity);
+}
+
+TEST(CompiledModulus, Chains) {
+    // Repetitions found using the orders are the same as the ones found by comparing constants
+    using tables = compiled_modulus<10UL, 1007UL>;
+
+    for (uint64_t base = 1UL; base < 1007UL; ++base) {
+        if (tables::orders[base] == 0UL) {
+            continue;
+        }
+
+        auto chain = squaring_chain(base, tables::nb_bits, 1007UL);
+
+        for (uint64_t idx = 0UL; idx < chain.size(); ++idx) {
+            ASSERT_EQ(tables::chains[base][idx].constant, chain[idx].constant);
+            ASSERT_EQ(tables::chains[base][idx].identity, chain[idx].identity);
+            ASSERT_EQ(tables::chains[base][idx].first_occurrence, chain[idx].first_occurrence) << "base " << base << ", step " << idx;
+        }
+    }
+}
+
+
+/**
+ * Test post-processing using tables
+ */
+
+TEST(CompiledModulus, PostProcess) {
+    using tables = compiled_modulus<4UL, 15UL>;
+
+    auto success = tables::post_process(64UL, 7UL);
+    EXPECT_EQ(success.outcome, attempt_outcome::success);
+    EXPECT_EQ(success.order, 4UL);
+    EXPECT_EQ(success.factors, std::vector<uint64_t>({ 3UL, 5UL }));
+
+    auto gcd = tables::post_process(0UL, 12UL);
+    EXPECT_EQ(gcd.outcome, attempt_outcome::classical_gcd);
+    EXPECT_EQ(gcd.factors, std::vector<uint64_t>({ 3UL, 5UL }));
+
+    EXPECT_EQ(tables::post_process(128UL, 14UL).outcome, attempt_outcome::trivial_split);
+}
+
+TEST(CompiledModulus, FailureModes) {
+    using tables = compiled_modulus<5UL, 21UL>;
+
+    EXPECT_EQ(tables::post_process(0UL, 2UL).outcome, attempt_outcome::no_candidate);
+    EXPECT_EQ(tables::post_process(341UL, 4UL).outcome, attempt_outcome::odd_order);
+}
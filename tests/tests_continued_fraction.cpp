@@ -6,6 +6,9 @@
 // Include Google tests and C++ stdlib
 #include <limits>
 #include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
 #include <gtest/gtest.h>
 
 // Include Q-Pragma shor
@@ -22,7 +25,7 @@ using qpragma::shor::continued_fraction;
  * continued fraction
  */
 template <typename NUM_TYPE>
-inline NUM_TYPE compute_fraction(const std::list<int64_t>::const_iterator & begin, const std::list<int64_t>::const_iterator & end) {
+inline NUM_TYPE compute_fraction(const std::vector<int64_t>::const_iterator & begin, const std::vector<int64_t>::const_iterator & end) {
     // Ensure begin differs from end
     if (begin == end) {
         throw std::runtime_error("Could not compute fraction - fraction is empty");
@@ -46,7 +49,7 @@ TEST(ContinuedFraction, DecompositionGreaterThanOne) {
     fraction my_fraction(15625UL, 6842UL);
     auto decomposition = continued_fraction(my_fraction);
 
-    ASSERT_EQ(decomposition, std::list<int64_t>({ 2L, 3L, 1L, 1L, 9L, 1L, 1L, 48L }));
+    ASSERT_EQ(decomposition, std::vector<int64_t>({ 2L, 3L, 1L, 1L, 9L, 1L, 1L, 48L }));
 }
 
 
@@ -54,7 +57,17 @@ TEST(ContinuedFraction, DecompositionLowerThanOne) {
     fraction my_fraction(17UL, 23UL);
     auto decomposition = continued_fraction(my_fraction);
 
-    ASSERT_EQ(decomposition, std::list<int64_t>({ 0L, 1L, 2L, 1L, 5L }));
+    ASSERT_EQ(decomposition, std::vector<int64_t>({ 0L, 1L, 2L, 1L, 5L }));
+}
+
+
+TEST(ContinuedFraction, ConstantExpression) {
+    static_assert(continued_fraction(fraction(17UL, 23UL)) == std::vector<int64_t>({ 0L, 1L, 2L, 1L, 5L }));
+    static_assert(qpragma::shor::find_candidate(fraction(192UL, 256UL), 7UL, 15UL) == 4UL);
+    static_assert(pow_mod(3UL, 13UL, 143UL) == 16UL);
+    static_assert(qpragma::shor::mod_inverse(7UL, 15UL) == 13UL);
+    static_assert(fraction(3UL, 4UL) - fraction(1UL, 2UL) == fraction(1UL, 4UL));
+    static_assert(fraction(1UL, 2UL) - fraction(3UL, 4UL) == - fraction(1UL, 4UL));
 }
 
 
@@ -112,6 +125,13 @@ TEST(Pow, PowerOfTwo) {
     }
 }
 
+TEST(Pow, LargeModulus) {
+    // Products do not overflow: 2^61 - 1 is prime (Fermat's little theorem)
+    constexpr uint64_t prime = (1UL << 61UL) - 1UL;
+    EXPECT_EQ(pow_mod(3UL, prime - 1UL, prime), 1UL);
+    EXPECT_EQ(qpragma::shor::mul_mod(prime - 1UL, prime - 1UL, prime), 1UL);
+}
+
 
 TEST(Pow, Fixed) {
     // Pow(5, 7)
@@ -147,3 +167,28 @@ TEST(Pow, Fixed) {
         ASSERT_EQ(result, 16UL);
     }
 }
+
+
+/**
+ * Test function qpragma::shor::mod_inverse and ensure that this function
+ * returns the expected result
+ */
+
+TEST(ModInverse, Coprime) {
+    for (uint64_t modulus: { 15UL, 21UL, 35UL, 143UL, 1000003UL }) {
+        for (uint64_t value = 1UL; value < std::min(modulus, 500UL); ++value) {
+            if (std::gcd(value, modulus) != 1UL) {
+                continue;
+            }
+
+            auto inverse = qpragma::shor::mod_inverse(value, modulus);
+            ASSERT_LT(inverse, modulus);
+            ASSERT_EQ((value * inverse) % modulus, 1UL) << value << "^(-1) % " << modulus << " is not equal to " << inverse;
+        }
+    }
+}
+
+
+TEST(ModInverse, NotCoprime) {
+    ASSERT_THROW(qpragma::shor::mod_inverse(6UL, 15UL), std::domain_error);
+}
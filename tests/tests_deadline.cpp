@@ -0,0 +1,42 @@
+/**
+ * This test file ensure that the deadline defined in "qpragma/shor/deadline.h"
+ * works as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <chrono>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/deadline.h"
+
+using qpragma::shor::deadline;
+
+
+/**
+ * Test class qpragma::shor::deadline
+ */
+
+TEST(Deadline, Infinite) {
+    deadline limit;
+
+    EXPECT_TRUE(limit.is_infinite());
+    EXPECT_FALSE(limit.expired());
+    EXPECT_EQ(limit.remaining(), std::chrono::milliseconds::max());
+}
+
+TEST(Deadline, Expired) {
+    deadline limit(std::chrono::milliseconds(0));
+
+    EXPECT_FALSE(limit.is_infinite());
+    EXPECT_TRUE(limit.expired());
+    EXPECT_EQ(limit.remaining(), std::chrono::milliseconds(0));
+}
+
+TEST(Deadline, Remaining) {
+    deadline limit(std::chrono::hours(1));
+
+    EXPECT_FALSE(limit.expired());
+    EXPECT_LE(limit.remaining(), std::chrono::hours(1));
+    EXPECT_GT(limit.remaining(), std::chrono::minutes(59));
+}
@@ -0,0 +1,342 @@
+/**
+ * This test file ensure that the statevector emulator defined in
+ * "qpragma/shor/emulator.h" works as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <map>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/emulator.h"
+#include "qpragma/shor/post_processing.h"
+
+using qpragma::shor::statevector;
+using qpragma::shor::emulator_session;
+using qpragma::shor::sample_phases;
+using qpragma::shor::squaring_chain;
+using qpragma::shor::random_stream;
+using qpragma::shor::attempt_outcome;
+using qpragma::shor::storage_options;
+using qpragma::shor::storage_backend;
+using qpragma::shor::make_storage;
+using qpragma::shor::thread_pool;
+using qpragma::shor::prefetch_thread;
+using qpragma::shor::engine_options;
+using qpragma::shor::emulator_engine;
+using qpragma::shor::reference_engine;
+using qpragma::shor::parallel_engine;
+
+
+/**
+ * Test storages
+ */
+
+TEST(Storage, MappedClone) {
+    storage_options options { .backend = storage_backend::mapped, .block_size = 100UL };
+    auto storage = make_storage(1000UL, options);
+    ASSERT_TRUE(storage->out_of_core());
+    EXPECT_EQ(storage->block_size(), 100UL);
+
+    storage->data()[3] = { 1., 2. };
+    storage->data()[999] = { -1., 0. };
+    storage->prefetch(900UL, 200UL);
+
+    auto copy = storage->clone(true);
+    auto empty = storage->clone(false);
+    storage->data()[3] = { 0., 0. };
+
+    EXPECT_EQ(copy->data()[3], qpragma::shor::amplitude(1., 2.));
+    EXPECT_EQ(copy->data()[999], qpragma::shor::amplitude(-1., 0.));
+    EXPECT_EQ(empty->data()[999], qpragma::shor::amplitude(0., 0.));
+}
+
+
+/**
+ * Test engines
+ */
+
+TEST(Engine, ThreadPool) {
+    thread_pool pool(4UL);
+    std::vector<uint64_t> calls(pool.size(), 0UL);
+    ASSERT_EQ(pool.size(), 4UL);
+
+    for (uint64_t idx = 0UL; idx < 100UL; ++idx) {
+        pool.run([&](uint64_t thread_idx) { ++calls[thread_idx]; });
+    }
+
+    EXPECT_EQ(calls, std::vector<uint64_t>(4UL, 100UL));
+}
+
+TEST(Engine, ThreadPoolException) {
+    // Exceptions of the workers (and of the calling thread) are rethrown by "run", the pool
+    // can be used afterwards
+    thread_pool pool(4UL);
+    std::vector<uint64_t> calls(pool.size(), 0UL);
+
+    EXPECT_THROW(pool.run([](uint64_t thread_idx) { if (thread_idx == 2UL) throw std::bad_alloc(); }), std::bad_alloc);
+    EXPECT_THROW(pool.run([](uint64_t thread_idx) { if (thread_idx == 0UL) throw std::runtime_error("caller"); }), std::runtime_error);
+
+    pool.run([&](uint64_t thread_idx) { ++calls[thread_idx]; });
+    EXPECT_EQ(calls, std::vector<uint64_t>(4UL, 1UL));
+}
+
+TEST(Engine, PrefetchThread) {
+    // Tasks are executed one after the other on the same thread, exceptions are rethrown by "wait"
+    prefetch_thread thread;
+    std::vector<std::thread::id> threads;
+
+    for (uint64_t idx = 0UL; idx < 10UL; ++idx) {
+        thread.submit([&threads]() { threads.push_back(std::this_thread::get_id()); });
+        thread.wait();
+    }
+
+    ASSERT_EQ(threads.size(), 10UL);
+    EXPECT_NE(threads[0], std::this_thread::get_id());
+    EXPECT_EQ(std::count(threads.begin(), threads.end(), threads[0]), 10L);
+
+    thread.submit([]() { throw std::runtime_error("prefetch"); });
+    EXPECT_THROW(thread.wait(), std::runtime_error);
+    EXPECT_NO_THROW(thread.wait());
+}
+
+TEST(Engine, ParallelKernels) {
+    // Tiles (7 amplitudes) are not aligned on N = 91, nor on the ranges of the threads
+    storage_options options;
+    auto input = make_storage(128UL, options);
+    random_stream stream(11UL, 91UL, 0UL);
+
+    for (uint64_t idx = 0UL; idx < 128UL; ++idx) {
+        input->data()[idx] = { stream.canonical() - 0.5, stream.canonical() - 0.5 };
+    }
+
+    reference_engine reference;
+    parallel_engine parallel(engine_options { .engine = emulator_engine::parallel, .nb_threads = 3UL, .tile_size = 7UL });
+    const qpragma::shor::amplitude phase = std::polar(1., 0.7);
+
+    EXPECT_NEAR(parallel.norm(*input, 45UL, 91UL, phase), reference.norm(*input, 45UL, 91UL, phase), 1e-12);
+
+    auto expected = input->allocate();
+    auto result = make_storage(128UL, options, false);
+    parallel.fill_zeros(*result);
+    reference.combine(*input, *expected, 45UL, 91UL, phase, 0.3);
+    parallel.combine(*input, *result, 45UL, 91UL, phase, 0.3);
+
+    for (uint64_t idx = 0UL; idx < 128UL; ++idx) {
+        EXPECT_NEAR(std::abs(result->data()[idx] - expected->data()[idx]), 0., 1e-12) << idx;
+    }
+
+    auto copy = input->allocate();
+    parallel.copy(*input, *copy);
+    EXPECT_TRUE(std::equal(input->data(), input->data() + 128UL, copy->data()));
+}
+
+
+/**
+ * Test statevector
+ */
+
+TEST(Statevector, RegisterSize) {
+    // 2^40 amplitudes are only supported out-of-core
+    storage_options mapped { .backend = storage_backend::mapped };
+    EXPECT_THROW(statevector(0UL), std::out_of_range);
+    EXPECT_THROW(statevector(40UL), std::out_of_range);
+    EXPECT_THROW(statevector(48UL, std::make_shared<emulator_session>(mapped, engine_options())), std::out_of_range);
+}
+
+TEST(Statevector, Projection) {
+    // First non-trivial step of 7 mod 15 (multiplication by 4, angle 0): |1> and |4> are
+    // swapped, both outcomes are equally likely
+    auto chain = squaring_chain(7UL, 8UL, 15UL);
+    statevector state(4UL);
+
+    double probability = state.probability(chain[6], 15UL, 0.);
+    EXPECT_NEAR(probability, 0.5, 1e-12);
+
+    state.project(chain[6], 15UL, 0., true, 1. - probability);
+    EXPECT_NEAR(std::norm(state.amplitudes()[1]), 0.5, 1e-12);
+    EXPECT_NEAR(std::norm(state.amplitudes()[4]), 0.5, 1e-12);
+    EXPECT_NEAR(std::real(state.amplitudes()[1] + state.amplitudes()[4]), 0., 1e-12);
+}
+
+
+/**
+ * Test shot tree
+ */
+
+TEST(ShotTree, ExactPhases) {
+    // The order of 7 modulo 15 is 4: measurements are multiples of 2^8 / 4
+    auto chain = squaring_chain(7UL, 8UL, 15UL);
+    random_stream stream(1UL, 15UL, 7UL);
+    auto measurements = sample_phases(chain, 15UL, 4UL, 1000UL, stream);
+    std::map<uint64_t, uint64_t> counts;
+
+    ASSERT_EQ(measurements.size(), 1000UL);
+
+    for (uint64_t measurement: measurements) {
+        ASSERT_EQ(measurement % 64UL, 0UL);
+        ++counts[measurement];
+    }
+
+    for (auto [measurement, count]: counts) {
+        EXPECT_GT(count, 200UL) << measurement;
+        EXPECT_LT(count, 300UL) << measurement;
+    }
+}
+
+TEST(ShotTree, PhaseCorrection) {
+    // The order of 2 modulo 21 is 6: the phases k / 6 are not exact on 10 bits, measurements
+    // are close to k * 2^10 / 6 only if the phase corrections of the previous bits are exact
+    auto chain = squaring_chain(2UL, 10UL, 21UL);
+    random_stream stream(3UL, 21UL, 2UL);
+    uint64_t nb_close = 0UL;
+
+    for (uint64_t measurement: sample_phases(chain, 21UL, 5UL, 400UL, stream)) {
+        double distance = std::remainder(6. * static_cast<double>(measurement), 1024.) / 6.;
+        nb_close += std::abs(distance) <= 1. ? 1UL : 0UL;
+    }
+
+    EXPECT_GT(nb_close, 300UL);
+}
+
+TEST(ShotTree, Shuffled) {
+    // Measurements of 7 mod 15 are 4 equally likely values: about 1 consecutive pair out of 4 is
+    // equal once shuffled (the leaves of the tree give runs of equal measurements)
+    auto chain = squaring_chain(7UL, 8UL, 15UL);
+    random_stream stream(1UL, 15UL, 7UL);
+    auto measurements = sample_phases(chain, 15UL, 4UL, 1000UL, stream);
+    uint64_t nb_equal = 0UL;
+
+    for (uint64_t idx = 1UL; idx < measurements.size(); ++idx) {
+        nb_equal += measurements[idx] == measurements[idx - 1UL] ? 1UL : 0UL;
+    }
+
+    EXPECT_GT(nb_equal, 200UL);
+    EXPECT_LT(nb_equal, 300UL);
+}
+
+TEST(ShotTree, Reproducible) {
+    auto chain = squaring_chain(2UL, 10UL, 21UL);
+    random_stream first(5UL, 21UL, 2UL);
+    random_stream second(5UL, 21UL, 2UL);
+
+    EXPECT_EQ(sample_phases(chain, 21UL, 5UL, 64UL, first), sample_phases(chain, 21UL, 5UL, 64UL, second));
+}
+
+TEST(ShotTree, MeasuredBits) {
+    // Measurements are stored in 63 bits
+    random_stream stream(5UL, 21UL, 2UL);
+    EXPECT_EQ(sample_phases(squaring_chain(2UL, 63UL, 21UL), 21UL, 5UL, 1UL, stream).size(), 1UL);
+    EXPECT_THROW(sample_phases(squaring_chain(2UL, 64UL, 21UL), 21UL, 5UL, 1UL, stream), std::out_of_range);
+}
+
+TEST(ShotTree, OutOfCore) {
+    // Mapped blocks (smaller than the register) give the same measurements as the memory
+    auto chain = squaring_chain(2UL, 14UL, 91UL);
+    storage_options options { .backend = storage_backend::mapped, .block_size = 24UL };
+    random_stream first(3UL, 91UL, 2UL);
+    random_stream second(3UL, 91UL, 2UL);
+
+    EXPECT_EQ(sample_phases(chain, 91UL, 7UL, 32UL, first), sample_phases(chain, 91UL, 7UL, 32UL, second, options));
+}
+
+TEST(ShotTree, ParallelEngine) {
+    auto chain = squaring_chain(7UL, 8UL, 15UL);
+    random_stream stream(1UL, 15UL, 7UL);
+    engine_options engine { .engine = emulator_engine::parallel, .nb_threads = 2UL, .tile_size = 5UL };
+
+    for (uint64_t measurement: sample_phases(chain, 15UL, 4UL, 100UL, stream, storage_options(), engine)) {
+        EXPECT_EQ(measurement % 64UL, 0UL);
+    }
+}
+
+TEST(ShotTree, SuccessRate) {
+    // The order of 2 modulo 21 is 6, most measurements lead to a divisor
+    auto chain = squaring_chain(2UL, 10UL, 21UL);
+    random_stream stream(9UL, 21UL, 2UL);
+    uint64_t nb_success = 0UL;
+
+    for (uint64_t measurement: sample_phases(chain, 21UL, 5UL, 200UL, stream)) {
+        if (qpragma::shor::post_process(measurement, 10UL, 2UL, 21UL).outcome == attempt_outcome::success) {
+            ++nb_success;
+        }
+    }
+
+    EXPECT_GT(nb_success, 60UL);
+}
+
+
+/**
+ * Test emulator session
+ */
+
+TEST(Session, RecycledStorages) {
+    // Attempts on a session give the same measurements as attempts on new sessions, storages
+    // of the first attempt are reused by the next ones (which sample the same tree) if the
+    // session keeps enough storages
+    auto chain = squaring_chain(2UL, 10UL, 21UL);
+    auto session = std::make_shared<emulator_session>(storage_options(), engine_options(), 64UL);
+    random_stream first(5UL, 21UL, 2UL);
+    random_stream second(5UL, 21UL, 2UL);
+
+    EXPECT_EQ(sample_phases(chain, 21UL, 5UL, 64UL, first, session), sample_phases(chain, 21UL, 5UL, 64UL, second));
+
+    uint64_t nb_allocations = session->nb_allocations();
+    EXPECT_GT(nb_allocations, 0UL);
+
+    for (uint64_t attempt = 0UL; attempt < 4UL; ++attempt) {
+        random_stream first_stream(5UL, 21UL, 2UL);
+        random_stream second_stream(5UL, 21UL, 2UL);
+        EXPECT_EQ(sample_phases(chain, 21UL, 5UL, 64UL, first_stream, session), sample_phases(chain, 21UL, 5UL, 64UL, second_stream));
+    }
+
+    EXPECT_EQ(session->nb_allocations(), nb_allocations);
+}
+
+TEST(Session, ReleasedStorages) {
+    // A session keeps two storages by default: single-shot attempts reuse them, the storages of
+    // the pending states of a shot tree are freed
+    auto chain = squaring_chain(2UL, 10UL, 21UL);
+    auto session = std::make_shared<emulator_session>();
+
+    for (uint64_t attempt = 0UL; attempt < 4UL; ++attempt) {
+        random_stream stream(5UL, 21UL, attempt);
+        sample_phases(chain, 21UL, 5UL, 1UL, stream, session);
+    }
+
+    EXPECT_EQ(session->nb_allocations(), 2UL);
+    EXPECT_EQ(session->nb_released(), 2UL);
+
+    random_stream stream(5UL, 21UL, 2UL);
+    sample_phases(chain, 21UL, 5UL, 64UL, stream, session);
+    EXPECT_GT(session->nb_allocations(), 2UL);
+    EXPECT_EQ(session->nb_released(), 2UL);
+}
+
+TEST(Session, ResetAmplitudes) {
+    // A recycled storage is reset to |1>, on memory and on mapped files
+    auto chain = squaring_chain(7UL, 8UL, 15UL);
+
+    for (auto backend: { storage_backend::memory, storage_backend::mapped }) {
+        auto session = std::make_shared<emulator_session>(storage_options { .backend = backend, .block_size = 4UL });
+
+        {
+            statevector state(4UL, session);
+            state.project(chain[6], 15UL, 0., true, 0.5);
+            state.project(chain[6], 15UL, 0., true, 0.5);
+        }
+
+        statevector state(4UL, session);
+        EXPECT_EQ(session->nb_allocations(), 2UL);
+
+        for (uint64_t idx = 0UL; idx < 16UL; ++idx) {
+            EXPECT_EQ(state.amplitudes()[idx], qpragma::shor::amplitude(idx == 1UL ? 1. : 0., 0.)) << idx;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * This test file ensure that the lattice post-processing defined in
+ * "qpragma/shor/lattice.h" works as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <vector>
+#include <numeric>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/lattice.h"
+#include "qpragma/shor/emulator.h"
+
+using qpragma::shor::lll_reduce;
+using qpragma::shor::lattice_runs;
+using qpragma::shor::post_process_runs;
+using qpragma::shor::sample_phases;
+using qpragma::shor::squaring_chain;
+using qpragma::shor::random_stream;
+using qpragma::shor::attempt_outcome;
+
+
+/**
+ * Test LLL reduction
+ */
+
+TEST(LLL, ShortestVector) {
+    // The lattice spanned by (1, 1, 1), (-1, 0, 2) and (3, 5, 6) contains (0, 1, 0)
+    std::vector<std::vector<int64_t>> basis = { { 1, 1, 1 }, { -1, 0, 2 }, { 3, 5, 6 } };
+    lll_reduce(basis);
+
+    int64_t first_norm = std::inner_product(basis[0].begin(), basis[0].end(), basis[0].begin(), int64_t(0));
+    EXPECT_EQ(first_norm, 1);
+
+    // The determinant is preserved
+    int64_t determinant =
+        basis[0][0] * (basis[1][1] * basis[2][2] - basis[1][2] * basis[2][1])
+        - basis[0][1] * (basis[1][0] * basis[2][2] - basis[1][2] * basis[2][0])
+        + basis[0][2] * (basis[1][0] * basis[2][1] - basis[1][1] * basis[2][0]);
+    EXPECT_EQ(std::abs(determinant), 3);
+}
+
+
+/**
+ * Test lattice post-processing
+ */
+
+TEST(LatticePostProcess, Runs) {
+    EXPECT_EQ(lattice_runs(10UL, 13UL), 5UL);
+    EXPECT_EQ(lattice_runs(10UL, 20UL), 2UL);
+    EXPECT_THROW(lattice_runs(10UL, 10UL), std::out_of_range);
+}
+
+TEST(LatticePostProcess, ExactPhases) {
+    // The order of 3 modulo 1007 is 468: measurements are the closest integers to 2^13 k / 468
+    std::vector<uint64_t> measurements;
+
+    for (uint64_t k_value: { 5UL, 77UL, 130UL, 301UL, 466UL }) {
+        measurements.push_back((k_value * (1UL << 13UL) + 234UL) / 468UL);
+    }
+
+    auto result = post_process_runs(measurements, 13UL, 3UL, 1007UL);
+    EXPECT_EQ(result.outcome, attempt_outcome::success);
+    EXPECT_EQ(result.order, 468UL);
+    EXPECT_EQ(result.factors, std::vector<uint64_t>({ 19UL, 53UL }));
+}
+
+TEST(LatticePostProcess, EmulatedRuns) {
+    // Runs of 13 bits instead of 20: most groups of runs give the order (shots are shuffled,
+    // consecutive measurements are independent runs)
+    const uint64_t nb_runs = lattice_runs(10UL, 13UL);
+    auto chain = squaring_chain(3UL, 13UL, 1007UL);
+    random_stream stream(4UL, 1007UL, 3UL);
+    auto measurements = sample_phases(chain, 1007UL, 10UL, 20UL * nb_runs, stream);
+    uint64_t nb_success = 0UL;
+
+    for (uint64_t first = 0UL; first < measurements.size(); first += nb_runs) {
+        auto runs = std::span<const uint64_t>(measurements).subspan(first, nb_runs);
+
+        if (post_process_runs(runs, 13UL, 3UL, 1007UL).outcome == attempt_outcome::success) {
+            ++nb_success;
+        }
+    }
+
+    EXPECT_GE(nb_success, 15UL);
+}
@@ -0,0 +1,87 @@
+/**
+ * This test file ensure that the modular multipliers defined in
+ * "qpragma/shor/multiplier.h" compute constant * x modulo N on every basis input
+ *
+ * These tests execute quantum scopes: they are built with the Q-Pragma plugin
+ * (see "qpragma-shor-quantum-tests" target)
+ */
+
+// Include Google tests and C++ stdlib
+#include <cstdint>
+#include <numeric>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/multiplier.h"
+
+using qpragma::shor::qpragma_multiplier;
+using qpragma::shor::draper_multiplier;
+using qpragma::shor::ripple_carry_multiplier;
+
+
+/**
+ * Multiply the basis state |x> by a constant modulo N, and measure the register
+ */
+template <uint64_t SIZE, typename MULTIPLIER>
+uint64_t multiply(uint64_t constant, uint64_t N_value, uint64_t x) {
+    typename MULTIPLIER::template circuit<SIZE> circuit(constant, N_value);
+    uint64_t result = 0UL;
+
+    #pragma quantum scope with(circuit, x, result)
+    {
+        qpragma::quint_t<SIZE> reg = x;
+        circuit(reg);
+
+        for (uint64_t idx = 0UL; idx < SIZE; ++idx) {
+            if (qpragma::measure_and_reset(reg[idx])) {
+                result += 1UL << idx;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Check every basis input x < N, for every constant coprime with N
+ */
+template <uint64_t SIZE, typename MULTIPLIER>
+void check_multiplier(uint64_t N_value) {
+    for (uint64_t constant = 2UL; constant < N_value; ++constant) {
+        if (std::gcd(constant, N_value) != 1UL) {
+            continue;
+        }
+
+        for (uint64_t x = 0UL; x < N_value; ++x) {
+            EXPECT_EQ((multiply<SIZE, MULTIPLIER>(constant, N_value, x)), constant * x % N_value)
+                << constant << " * " << x << " modulo " << N_value;
+        }
+    }
+}
+
+
+/**
+ * Test each multiplier
+ */
+
+TEST(Multiplier, QPragma) {
+    check_multiplier<4UL, qpragma_multiplier>(15UL);
+    check_multiplier<5UL, qpragma_multiplier>(21UL);
+}
+
+
+TEST(Multiplier, Draper) {
+    // The QFT is exact for these sizes: the result is deterministic
+    static_assert(draper_multiplier::approximation(3UL) > 3UL);
+    static_assert(draper_multiplier::approximation(4UL) > 4UL);
+
+    check_multiplier<3UL, draper_multiplier>(7UL);
+    check_multiplier<4UL, draper_multiplier>(15UL);
+}
+
+
+TEST(Multiplier, RippleCarry) {
+    check_multiplier<4UL, ripple_carry_multiplier>(15UL);
+    check_multiplier<5UL, ripple_carry_multiplier>(21UL);
+}
@@ -0,0 +1,181 @@
+/**
+ * This test file ensure that functions defined in "qpragma/shor/post_processing.h"
+ * work as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <chrono>
+#include <numeric>
+#include <functional>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/continued_fraction.h"
+#include "qpragma/shor/post_processing.h"
+
+using qpragma::shor::pow_mod;
+using qpragma::shor::post_process;
+using qpragma::shor::attempt_budget;
+using qpragma::shor::estimate_prime_factors;
+using qpragma::shor::attempt_outcome;
+using qpragma::shor::split_with_order;
+using qpragma::shor::process_order;
+using qpragma::shor::deadline;
+
+
+/**
+ * Compute the order of x modulo N (naive implementation)
+ */
+inline uint64_t naive_order(uint64_t x_value, uint64_t N_value) {
+    uint64_t order = 1UL;
+
+    for (uint64_t value = x_value % N_value; value != 1UL; value = (value * x_value) % N_value) {
+        ++order;
+    }
+
+    return order;
+}
+
+
+/**
+ * Test function qpragma::shor::split_with_order and ensure every divisor
+ * yielded by an order is extracted
+ */
+
+TEST(SplitWithOrder, BothSquareRoots) {
+    // The order of 7 modulo 15 is 4: 7^2 = 4 and gcd(3, 15) = 3, gcd(5, 15) = 5
+    auto factors = split_with_order(7UL, 4UL, 15UL);
+    ASSERT_EQ(factors, std::vector<uint64_t>({ 3UL, 5UL }));
+}
+
+
+TEST(SplitWithOrder, ThreePrimeFactors) {
+    // 3 * 5 * 7 = 105: the order of 2 is 12, the cofactors are split using the same order
+    auto factors = split_with_order(2UL, naive_order(2UL, 105UL), 105UL);
+    ASSERT_EQ(factors, std::vector<uint64_t>({ 3UL, 5UL, 7UL }));
+}
+
+
+TEST(SplitWithOrder, OddOrder) {
+    // The order of 4 modulo 15 is 2, the order of 16 modulo 21 is 3
+    ASSERT_EQ(split_with_order(16UL, 3UL, 21UL), std::vector<uint64_t>({ 21UL }));
+}
+
+
+TEST(SplitWithOrder, ProductIsPreserved) {
+    for (uint64_t N_value: { 15UL, 21UL, 33UL, 35UL, 91UL, 105UL, 143UL, 1155UL }) {
+        for (uint64_t base = 2UL; base < N_value; ++base) {
+            if (std::gcd(base, N_value) != 1UL) {
+                continue;
+            }
+
+            auto factors = split_with_order(base, naive_order(base, N_value), N_value);
+            uint64_t product = std::accumulate(factors.begin(), factors.end(), 1UL, std::multiplies<uint64_t>());
+
+            ASSERT_EQ(product, N_value) << "Factors of " << N_value << " found using base " << base << " are invalid";
+        }
+    }
+}
+
+
+/**
+ * Test function qpragma::shor::post_process and ensure failure modes
+ * are correctly classified
+ */
+
+TEST(PostProcess, FailureModes) {
+    // Base not coprime with N
+    ASSERT_EQ(post_process(0UL, 8UL, 6UL, 15UL).outcome, attempt_outcome::classical_gcd);
+
+    // Measurement 0 gives no information (the order of 2 modulo 21 is 6)
+    ASSERT_EQ(post_process(0UL, 8UL, 2UL, 21UL).outcome, attempt_outcome::no_candidate);
+
+    // 34 = -1 modulo 35, 34^2 = 1
+    ASSERT_EQ(post_process(128UL, 8UL, 34UL, 35UL).outcome, attempt_outcome::trivial_split);
+
+    // The order of 4 modulo 21 is 3
+    ASSERT_EQ(post_process(85UL, 8UL, 4UL, 21UL).outcome, attempt_outcome::odd_order);
+
+    // Measurements are stored in 63 bits
+    ASSERT_THROW(post_process(0UL, 64UL, 2UL, 21UL), std::out_of_range);
+}
+
+
+TEST(PostProcess, ConvergentNotCoprime) {
+    // 7 has order 4 modulo 15: the measurement 128/256 = 2/4 is simplified into 1/2, the
+    // order is recovered as a multiple of the convergent denominator
+    auto result = post_process(128UL, 8UL, 7UL, 15UL);
+
+    ASSERT_EQ(result.outcome, attempt_outcome::success);
+    ASSERT_EQ(result.order, 4UL);
+    ASSERT_EQ(result.factors, std::vector<uint64_t>({ 3UL, 5UL }));
+}
+
+
+/**
+ * Test class qpragma::shor::attempt_budget and ensure the budget adapts
+ * to observed failures
+ */
+
+TEST(AttemptBudget, Adaptive) {
+    attempt_budget budget(1e-3, 2UL, 200UL);
+    uint64_t initial_total = budget.total();
+
+    ASSERT_GT(initial_total, 1UL);
+    ASSERT_LT(initial_total, budget.maximum());
+
+    // Many orders are not found: more attempts are needed
+    for (uint8_t idx = 0; idx < 10; ++idx) {
+        budget.record(attempt_outcome::no_candidate);
+    }
+
+    ASSERT_GT(budget.total(), initial_total);
+    ASSERT_FALSE(budget.exhausted());
+
+    // A budget can not exceed its maximum
+    for (uint8_t idx = 0; idx < 250; ++idx) {
+        budget.record(attempt_outcome::trivial_split);
+    }
+
+    ASSERT_EQ(budget.total(), budget.maximum());
+    ASSERT_TRUE(budget.exhausted());
+}
+
+
+TEST(AttemptBudget, MorePrimeFactors) {
+    ASSERT_LT(attempt_budget(1e-3, 4UL).total(), attempt_budget(1e-3, 2UL).total());
+}
+
+
+TEST(AttemptBudget, EstimatePrimeFactors) {
+    ASSERT_EQ(estimate_prime_factors(15UL), 2UL);
+    ASSERT_EQ(estimate_prime_factors(105UL), 3UL);
+    ASSERT_EQ(estimate_prime_factors(3UL * 3UL * 5UL * 7UL * 11UL * 13UL), 5UL);
+
+    // Large prime factors are not found, the remaining cofactor counts as one prime factor
+    ASSERT_EQ(estimate_prime_factors(3UL * 1000003UL * 1000033UL), 2UL);
+    ASSERT_EQ(estimate_prime_factors(1000003UL * 1000033UL), 2UL);
+}
+
+
+/**
+ * Test attempts interrupted by the deadline
+ */
+
+TEST(PostProcessing, Interrupted) {
+    const deadline expired(std::chrono::milliseconds(0));
+
+    // No convergent is checked once the deadline has expired
+    auto attempt = post_process(64UL, 8UL, 7UL, 15UL, expired);
+    EXPECT_TRUE(attempt.interrupted);
+    EXPECT_TRUE(attempt.factors.empty());
+
+    EXPECT_FALSE(post_process(64UL, 8UL, 7UL, 15UL).interrupted);
+    EXPECT_TRUE(process_order(7UL, 0UL, 15UL, expired).interrupted);
+    EXPECT_FALSE(process_order(7UL, 0UL, 15UL).interrupted);
+
+    // Known failure modes are not interrupted: the order of 4 modulo 21 is 3
+    auto odd = process_order(4UL, 3UL, 21UL, expired);
+    EXPECT_EQ(odd.outcome, attempt_outcome::odd_order);
+    EXPECT_FALSE(odd.interrupted);
+}
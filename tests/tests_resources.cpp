@@ -0,0 +1,65 @@
+/**
+ * This test file ensure that the resource estimation defined in
+ * "qpragma/shor/resources.h" works as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <sstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/resources.h"
+#include "qpragma/shor/post_processing.h"
+
+using qpragma::shor::estimate_resources;
+using qpragma::shor::multiplier_cost;
+using qpragma::shor::attempt_budget;
+
+
+/**
+ * Test resources of the phase estimation
+ */
+
+TEST(Resources, WorstCase) {
+    // Without base, the 8 steps of a 4 qubits register apply a controlled multiplication
+    multiplier_cost cost { .ancillas = 6UL, .gates = 100UL, .depth = 50UL };
+    auto estimate = estimate_resources(4UL, 15UL, cost);
+
+    EXPECT_EQ(estimate.qubits, 1UL + 4UL + 6UL);
+    EXPECT_EQ(estimate.hadamard_gates, 16UL);
+    EXPECT_EQ(estimate.phase_gates, 8UL);
+    EXPECT_EQ(estimate.measurements, 8UL);
+    EXPECT_EQ(estimate.gates, 16UL + 8UL + 8UL * 100UL);
+    EXPECT_EQ(estimate.depth, 8UL * 4UL + 8UL * 50UL);
+    EXPECT_EQ(estimate.memory_bytes, (1UL << 11UL) * 16UL);
+}
+
+TEST(Resources, LeadingIdentities) {
+    // 4^2 = 1 modulo 15: only the last step uses the control qubit
+    multiplier_cost cost { .ancillas = 0UL, .gates = 10UL, .depth = 5UL };
+    auto estimate = estimate_resources(4UL, 15UL, cost, 4UL);
+
+    EXPECT_EQ(estimate.controlled_multiplications, 1UL);
+    EXPECT_EQ(estimate.synthesized_circuits, 1UL);
+    EXPECT_EQ(estimate.measurements, 1UL);
+    EXPECT_EQ(estimate.depth, 4UL + 5UL);
+}
+
+TEST(Resources, Attempts) {
+    // Attempts are the budget of "find_factors" for a semiprime
+    auto estimate = estimate_resources(4UL, 15UL, multiplier_cost());
+    attempt_budget budget;
+
+    EXPECT_DOUBLE_EQ(estimate.expected_attempts, 1. / budget.success_probability());
+    EXPECT_EQ(estimate.max_attempts, budget.total());
+
+    std::ostringstream stream;
+    stream << estimate;
+    EXPECT_NE(stream.str().find("Expected attempts"), std::string::npos);
+}
+
+TEST(Resources, NumberTooLarge) {
+    EXPECT_THROW(estimate_resources(4UL, 16UL, multiplier_cost()), std::out_of_range);
+    EXPECT_THROW(estimate_resources(64UL, 15UL, multiplier_cost()), std::out_of_range);
+}
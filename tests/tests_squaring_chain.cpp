@@ -0,0 +1,114 @@
+/**
+ * This test file ensure that the squaring chain defined in
+ * "qpragma/shor/squaring_chain.h" works as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/squaring_chain.h"
+#include "qpragma/shor/resources.h"
+
+using qpragma::shor::squaring_chain;
+using qpragma::shor::plan_circuits;
+using qpragma::shor::uses_control;
+using qpragma::shor::correction_angle;
+using qpragma::shor::chain_step;
+using qpragma::shor::estimate_resources;
+using qpragma::shor::multiplier_cost;
+
+
+/**
+ * Test constants of the squaring chain
+ */
+
+TEST(SquaringChain, Identities) {
+    // 7^4 = 1 modulo 15: only the two last multiplications are not trivial
+    auto chain = squaring_chain(7UL, 8UL, 15UL);
+    ASSERT_EQ(chain.size(), 8UL);
+
+    for (uint64_t idx = 0UL; idx < 6UL; ++idx) {
+        EXPECT_EQ(chain[idx].constant, 1UL);
+        EXPECT_TRUE(chain[idx].identity);
+        EXPECT_EQ(chain[idx].first_occurrence, 0UL);
+    }
+
+    EXPECT_EQ(chain[6].constant, 4UL);
+    EXPECT_FALSE(chain[6].identity);
+    EXPECT_EQ(chain[7].constant, 7UL);
+    EXPECT_FALSE(chain[7].identity);
+}
+
+TEST(SquaringChain, Repetitions) {
+    // Powers of 2 modulo 21 cycle between 4 and 16
+    auto chain = squaring_chain(2UL, 10UL, 21UL);
+    std::vector<uint64_t> expected = { 4UL, 16UL, 4UL, 16UL, 4UL, 16UL, 4UL, 16UL, 4UL, 2UL };
+
+    for (uint64_t idx = 0UL; idx < chain.size(); ++idx) {
+        EXPECT_EQ(chain[idx].constant, expected[idx]);
+        EXPECT_FALSE(chain[idx].identity);
+        EXPECT_EQ(chain[idx].first_occurrence, idx == 9UL ? 9UL : idx % 2UL);
+    }
+}
+
+
+/**
+ * Test circuits planned for the phase estimation
+ */
+
+TEST(SquaringChain, PlannedCircuits) {
+    // One circuit per distinct constant, identities are not applied
+    auto identities = plan_circuits(squaring_chain(7UL, 8UL, 15UL));
+    EXPECT_EQ(identities.constants, std::vector<uint64_t>({ 4UL, 7UL }));
+    EXPECT_EQ(identities.indexes[6], 0UL);
+    EXPECT_EQ(identities.indexes[7], 1UL);
+
+    auto repeated = plan_circuits(squaring_chain(2UL, 10UL, 21UL));
+    EXPECT_EQ(repeated.constants, std::vector<uint64_t>({ 4UL, 16UL, 2UL }));
+    EXPECT_EQ(repeated.indexes, std::vector<uint64_t>({ 0UL, 1UL, 0UL, 1UL, 0UL, 1UL, 0UL, 1UL, 0UL, 2UL }));
+}
+
+TEST(SquaringChain, UsesControl) {
+    chain_step identity;
+    chain_step multiplication { .constant = 4UL, .identity = false, .first_occurrence = 0UL };
+
+    EXPECT_FALSE(uses_control(identity, 0UL));
+    EXPECT_TRUE(uses_control(identity, 2UL));
+    EXPECT_TRUE(uses_control(multiplication, 0UL));
+}
+
+TEST(SquaringChain, CorrectionAngle) {
+    // Bits measured by the previous steps are the least significant bits of measurement / 2^(idx + 1)
+    EXPECT_DOUBLE_EQ(correction_angle(0UL, 5UL), 0.);
+    EXPECT_DOUBLE_EQ(correction_angle(1UL, 1UL), - M_PI / 2.);
+    EXPECT_DOUBLE_EQ(correction_angle(2UL, 2UL), - M_PI / 2.);
+    EXPECT_DOUBLE_EQ(correction_angle(3UL, 2UL), - 3. * M_PI / 4.);
+    EXPECT_DOUBLE_EQ(correction_angle(64UL, 7UL), - M_PI / 2.);
+}
+
+
+/**
+ * Test resources estimated for a given base
+ */
+
+TEST(SquaringChain, ElidedResources) {
+    multiplier_cost cost { .ancillas = 6UL, .gates = 100UL, .depth = 50UL };
+
+    auto worst = estimate_resources(4UL, 15UL, cost);
+    EXPECT_EQ(worst.controlled_multiplications, 8UL);
+    EXPECT_EQ(worst.synthesized_circuits, 8UL);
+    EXPECT_EQ(worst.measurements, 8UL);
+
+    auto trivial = estimate_resources(4UL, 15UL, cost, 7UL);
+    EXPECT_EQ(trivial.controlled_multiplications, 2UL);
+    EXPECT_EQ(trivial.synthesized_circuits, 2UL);
+    EXPECT_EQ(trivial.measurements, 2UL);
+    EXPECT_EQ(trivial.gates, 2UL * 100UL + 6UL);
+
+    auto repeated = estimate_resources(5UL, 21UL, cost, 2UL);
+    EXPECT_EQ(repeated.controlled_multiplications, 10UL);
+    EXPECT_EQ(repeated.synthesized_circuits, 3UL);
+}
@@ -0,0 +1,90 @@
+/**
+ * This test file ensure that traces defined in "qpragma/shor/trace.h"
+ * work as expected
+ */
+
+// Include Google tests and C++ stdlib
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <gtest/gtest.h>
+
+// Include Q-Pragma shor
+#include "qpragma/shor/trace.h"
+
+using qpragma::shor::trace_entry;
+using qpragma::shor::trace_reader;
+using qpragma::shor::trace_writer;
+using qpragma::shor::attempt_outcome;
+
+
+/**
+ * Test trace writer and trace reader
+ */
+
+TEST(Trace, WriteAndRead) {
+    auto path = (std::filesystem::temp_directory_path() / "qpragma-shor-trace.bin").string();
+    std::vector<trace_entry> entries = {
+        { 15UL, 4UL, 8UL, 7UL, 128UL, attempt_outcome::success },
+        { 35UL, 6UL, 12UL, 34UL, 2048UL, attempt_outcome::trivial_split },
+        { (1UL << 31UL) - 1UL, 31UL, 62UL, 123456789UL, (1UL << 61UL) + 5UL, attempt_outcome::no_candidate }
+    };
+
+    {
+        trace_writer writer(path);
+
+        for (const auto & entry: entries) {
+            writer.write(entry);
+        }
+    }
+
+    trace_reader reader(path);
+
+    for (const auto & entry: entries) {
+        ASSERT_EQ(reader.next(), entry);
+    }
+
+    ASSERT_FALSE(reader.next());
+}
+
+
+TEST(Trace, Replay) {
+    trace_entry entry { 15UL, 4UL, 8UL, 7UL, 128UL, attempt_outcome::success };
+    auto result = qpragma::shor::replay(entry);
+
+    ASSERT_EQ(result.outcome, entry.outcome);
+    ASSERT_EQ(result.factors, std::vector<uint64_t>({ 3UL, 5UL }));
+}
+
+
+TEST(Trace, InvalidTrace) {
+    auto path = (std::filesystem::temp_directory_path() / "qpragma-shor-invalid-trace.bin").string();
+
+    {
+        std::ofstream stream(path, std::ios::binary);
+        stream << "invalid trace";
+    }
+
+    ASSERT_THROW(trace_reader { path }, std::runtime_error);
+}
+
+
+TEST(Trace, InvalidEntries) {
+    auto path = (std::filesystem::temp_directory_path() / "qpragma-shor-invalid-entries.bin").string();
+    std::vector<trace_entry> entries = {
+        { 1UL, 4UL, 8UL, 0UL, 0UL, attempt_outcome::success },              // Modulo 1
+        { 15UL, 4UL, 8UL, 15UL, 128UL, attempt_outcome::success },          // Base not lower than N
+        { 15UL, 4UL, 64UL, 7UL, 128UL, attempt_outcome::success },          // Measurement of 64 bits
+        { 15UL, 4UL, 8UL, 7UL, 256UL, attempt_outcome::success }            // Measurement of 9 bits
+    };
+
+    for (const auto & entry: entries) {
+        {
+            trace_writer writer(path);
+            writer.write(entry);
+        }
+
+        trace_reader reader(path);
+        ASSERT_THROW(reader.next(), std::runtime_error);
+    }
+}